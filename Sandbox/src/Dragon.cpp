@@ -7,8 +7,8 @@ static constexpr zth::SpriteSize dragon_sprite_size = {
     .height = 192,
 };
 
-Dragon::Dragon(const zth::Texture& texture, const zth::Sprite& gold_bar)
-    : AnimatedSprite(texture, dragon_sprite_size, 3 * 4, 0.1f), _gold_bar(gold_bar)
+Dragon::Dragon(const zth::Texture& texture, const zth::IntRect& sprite_sheet_rect, const zth::Sprite& gold_bar)
+    : AnimatedSprite(texture, sprite_sheet_rect, dragon_sprite_size, 3 * 4, 0.1f), _gold_bar(gold_bar)
 {}
 
 void Dragon::on_update()
@@ -13,7 +13,7 @@ enum class Direction
 class Dragon : public zth::AnimatedSprite, public zth::Updatable
 {
 public:
-    explicit Dragon(const zth::Texture& texture, const zth::Sprite& gold_bar);
+    explicit Dragon(const zth::Texture& texture, const zth::IntRect& sprite_sheet_rect, const zth::Sprite& gold_bar);
 
     void on_update() override;
 
@@ -6,20 +6,37 @@ const static auto emoji = b::embed<"assets/emoji.png">();
 const static auto dragon_sprite_sheet = b::embed<"assets/dragon.png">();
 const static auto gold_bars = b::embed<"assets/gold.png">();
 
+// the indices of the images in the atlas
+static constexpr zth::usize dragon_image = 0;
+static constexpr zth::usize player_image = 1;
+static constexpr zth::usize gold_bars_image = 2;
+
+static zth::TextureAtlas& build_atlas(zth::TextureAtlas& atlas)
+{
+    auto add_image = [&](const auto& asset) {
+        // an image that failed to load still takes up its index
+        if (!atlas.add_image_from_memory(reinterpret_cast<const zth::u8*>(asset.data()), asset.size()))
+            atlas.add_image(sf::Image{});
+    };
+
+    add_image(dragon_sprite_sheet);
+    add_image(emoji);
+    add_image(gold_bars);
+
+    // the sprites end up with empty texture rects, so they simply don't show up
+    if (!atlas.build())
+        zth::logger->log_error("Failed to build the texture atlas.");
+
+    return atlas;
+}
+
 Level1::Level1()
-    : _dragon_texture(zth::Texture::from_memory(reinterpret_cast<const zth::u8*>(dragon_sprite_sheet.data()),
-                                                dragon_sprite_sheet.size())
-                          .value_or(zth::Texture{})),
-      _dragon(_dragon_texture, _gold_bars),
-      _player_texture(zth::Texture::from_memory(reinterpret_cast<const zth::u8*>(emoji.data()), emoji.size())
-                          .value_or(zth::Texture{})),
-      _player(_player_texture),
-      _gold_bars_texture(zth::Texture::from_memory(reinterpret_cast<const zth::u8*>(gold_bars.data()), gold_bars.size())
-                             .value_or(zth::Texture{})),
-      _gold_bars(_gold_bars_texture)
+    : _dragon(build_atlas(_atlas).texture(), _atlas.get_rect(dragon_image), _gold_bars),
+      _player(_atlas.texture(), _atlas.get_rect(player_image)),
+      _gold_bars(_atlas.texture(), _atlas.get_rect(gold_bars_image))
 {
     // register_updatable(_player);
-    register_updatable(_dragon);
+    _dragon_updatable = register_updatable(_dragon);
     _dragon.scale(3.0f, { 3.0f, 3.0f });
 
     register_animatable(_dragon);
@@ -35,8 +52,7 @@ Level1::Level1()
 
 Level1::~Level1()
 {
-    // deregister_updatable(_player);
-    deregister_updatable(_dragon);
+    deregister_updatable(_dragon_updatable);
 }
 
 void Level1::on_update() {}
@@ -12,13 +12,14 @@ public:
     ~Level1() override;
 
 private:
-    zth::Texture _dragon_texture;
+    // all the sprites of the level share one texture, so they get drawn with a single draw call
+    zth::TextureAtlas _atlas;
     Dragon _dragon;
-    zth::Texture _player_texture;
     Player _player;
-    zth::Texture _gold_bars_texture;
     zth::Sprite _gold_bars;
 
+    zth::UpdatableHandle _dragon_updatable;
+
 private:
     void on_update() override;
 };
@@ -1,6 +1,6 @@
 #include "Player.hpp"
 
-Player::Player(const zth::Texture& texture) : Sprite(texture) {}
+Player::Player(const zth::Texture& texture, const zth::IntRect& texture_rect) : Sprite(texture, texture_rect) {}
 
 void Player::on_update()
 {
@@ -5,7 +5,7 @@
 class Player : public zth::Sprite, public zth::Updatable
 {
 public:
-    explicit Player(const zth::Texture& texture);
+    explicit Player(const zth::Texture& texture, const zth::IntRect& texture_rect);
 
     void on_update() override;
 
@@ -0,0 +1,101 @@
+// renders primitives into a framebuffer without creating a window or an opengl context, so that it can run on
+// machines without a display, e.g. in ci
+// exits with 1 if any of the fill algorithms doesn't fill the shapes
+
+#include <Zenith/Graphics/CustomPrimitiveRenderer.hpp>
+#include <Zenith/Graphics/Framebuffer.hpp>
+#include <Zenith/Logging/Logger.hpp>
+
+#include <array>
+#include <format>
+
+static constexpr zth::Vec2u framebuffer_size = { 640, 360 };
+
+static void draw_primitives(zth::PrimitiveRenderer& renderer)
+{
+    static constexpr zth::Rect filled_rect = { .position = { 20.0f, 20.0f }, .size = { 180.0f, 90.0f } };
+
+    renderer.draw_filled_rect(filled_rect, zth::Color::blue);
+
+    static constexpr zth::Circle filled_circle = {
+        .center = { 300.0f, 65.0f },
+        .radius = 45.0f,
+    };
+
+    renderer.draw_filled_circle(filled_circle, zth::Color::green);
+
+    static constexpr zth::Triangle filled_triangle = {
+        zth::Vec2f{ 480.0f, 20.0f },
+        zth::Vec2f{ 400.0f, 110.0f },
+        zth::Vec2f{ 560.0f, 110.0f },
+    };
+
+    renderer.draw_filled_triangle(filled_triangle, zth::Color::red);
+
+    static constexpr zth::Ellipse ellipse = {
+        .center = { 320.0f, 250.0f },
+        .radius = { 200.0f, 60.0f },
+    };
+
+    renderer.draw_ellipse(ellipse, zth::Color::white);
+
+    // translucent shapes have to blend with the ones beneath them
+    static constexpr zth::Rect translucent_rect = { .position = { 150.0f, 60.0f }, .size = { 300.0f, 200.0f } };
+
+    renderer.draw_filled_rect(translucent_rect, { .r = 255, .g = 255, .b = 255, .a = 128 });
+}
+
+static bool has_color(const zth::Framebuffer& framebuffer, zth::u32 x, zth::u32 y, const zth::Color& color)
+{
+    auto pixel = framebuffer.get_pixel(x, y);
+    return pixel.r == color.r && pixel.g == color.g && pixel.b == color.b && pixel.a == color.a;
+}
+
+int main()
+{
+    struct NamedFillAlgorithm
+    {
+        zth::FillAlgorithm algorithm;
+        const char* name;
+    };
+
+    static constexpr std::array fill_algorithms = {
+        NamedFillAlgorithm{ zth::FillAlgorithm::Scanline, "scanline" },
+        NamedFillAlgorithm{ zth::FillAlgorithm::BoundaryFill, "boundary_fill" },
+        NamedFillAlgorithm{ zth::FillAlgorithm::FloodFill, "flood_fill" },
+    };
+
+    bool passed = true;
+
+    for (const auto& [fill_algorithm, name] : fill_algorithms)
+    {
+        zth::Framebuffer framebuffer{ framebuffer_size, zth::Color::black };
+        zth::CustomPrimitiveRenderer renderer{ framebuffer };
+        renderer.fill_algorithm = fill_algorithm;
+
+        draw_primitives(renderer);
+        renderer.flush();
+
+        // white at half opacity over blue, and over the opaque black background
+        const bool filled = has_color(framebuffer, 100, 40, zth::Color::blue)
+                            && has_color(framebuffer, 180, 80, { .r = 128, .g = 128, .b = 255, .a = 255 })
+                            && has_color(framebuffer, 300, 200, { .r = 128, .g = 128, .b = 128, .a = 255 });
+
+        const auto path = std::format("headless_test_{}.png", name);
+
+        if (!framebuffer.save_to_file(path))
+            zth::Logger::print_warning("Failed to save {}.", path);
+
+        if (filled)
+        {
+            zth::Logger::print_notification("Fill algorithm {} passed.", name);
+        }
+        else
+        {
+            zth::Logger::print_error("Fill algorithm {} failed.", name);
+            passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include "InstancedRendererTest.hpp"
+
+#include <Zenith/Core/Engine.hpp>
+#include <Zenith/Logging/Logger.hpp>
+
+#include <algorithm>
+#include <random>
+
+static constexpr zth::Vec2f area_size = { 1920.0f, 1080.0f };
+static constexpr float particle_size = 2.0f;
+
+InstancedRendererTest::InstancedRendererTest(zth::Renderer& renderer) : _renderer(renderer)
+{
+    std::mt19937 generator{ 0 };
+    std::uniform_real_distribution<float> x_distribution{ 0.0f, area_size.x };
+    std::uniform_real_distribution<float> y_distribution{ 0.0f, area_size.y };
+    std::uniform_real_distribution<float> velocity_distribution{ -200.0f, 200.0f };
+    std::uniform_int_distribution<int> channel_distribution{ 64, 255 };
+
+    auto random_channel = [&] { return static_cast<zth::u8>(channel_distribution(generator)); };
+
+    _particles.reserve(particle_count);
+
+    for (zth::usize i = 0; i < particle_count; i++)
+    {
+        _particles.push_back({
+            .position = { x_distribution(generator), y_distribution(generator) },
+            .velocity = { velocity_distribution(generator), velocity_distribution(generator) },
+            .color = { random_channel(), random_channel(), random_channel(), 255 },
+        });
+    }
+}
+
+void InstancedRendererTest::on_update()
+{
+    // moves 100k particles around the screen, half of them as rects and half as circles, which should take just two
+    // draw calls a frame, and prints the counters once a second
+
+    // the instances of a frame are counted once they're flushed at its end, so the stats come before drawing
+    if (_stats_timer.elapsed_s() > 1.0)
+        print_stats();
+
+    update_particles();
+    draw_particles();
+
+    _frame_count++;
+}
+
+void InstancedRendererTest::update_particles()
+{
+    const auto delta_time = static_cast<float>(zth::engine->delta_time());
+
+    for (auto& [position, velocity, color] : _particles)
+    {
+        position += velocity * delta_time;
+
+        // bounce off the edges of the screen
+        if (position.x < 0.0f || position.x > area_size.x)
+        {
+            velocity.x = -velocity.x;
+            position.x = std::clamp(position.x, 0.0f, area_size.x);
+        }
+
+        if (position.y < 0.0f || position.y > area_size.y)
+        {
+            velocity.y = -velocity.y;
+            position.y = std::clamp(position.y, 0.0f, area_size.y);
+        }
+    }
+}
+
+void InstancedRendererTest::draw_particles()
+{
+    auto& renderer = _renderer.instanced_renderer();
+    const auto half_count = _particles.size() / 2;
+
+    // every kind of instance is drawn in one go, a batch ends whenever the kind changes
+    for (zth::usize i = 0; i < half_count; i++)
+    {
+        const auto& particle = _particles[i];
+        renderer.draw_rect({ .position = particle.position, .size = { particle_size, particle_size } }, particle.color);
+    }
+
+    for (zth::usize i = half_count; i < _particles.size(); i++)
+    {
+        const auto& particle = _particles[i];
+        renderer.draw_circle({ .center = particle.position, .radius = particle_size }, particle.color);
+    }
+}
+
+void InstancedRendererTest::print_stats()
+{
+    auto& renderer = _renderer.instanced_renderer();
+    const auto frame_count = static_cast<double>(_frame_count);
+
+    zth::Logger::print_notification(
+        "Instanced rendering: {} instances and {} draw calls a frame, {} fps ({}).",
+        static_cast<double>(renderer.instance_count()) / frame_count,
+        static_cast<double>(renderer.draw_call_count()) / frame_count, zth::engine->fps(),
+        renderer.is_available() ? "instanced" : "expanded on the cpu");
+
+    renderer.reset_counters();
+    _frame_count = 0;
+    _stats_timer.reset();
+}
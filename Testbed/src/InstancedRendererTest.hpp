@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Zenith/Core/Scene.hpp>
+#include <Zenith/Graphics/Renderer.hpp>
+#include <Zenith/Time/Timer.hpp>
+
+#include <vector>
+
+class InstancedRendererTest : public zth::Scene
+{
+public:
+    static constexpr zth::usize particle_count = 100'000;
+
+public:
+    explicit InstancedRendererTest(zth::Renderer& renderer);
+
+private:
+    struct Particle
+    {
+        zth::Vec2f position;
+        zth::Vec2f velocity;
+        zth::Color color;
+    };
+
+    zth::Renderer& _renderer;
+    std::vector<Particle> _particles;
+
+    zth::Timer _stats_timer;
+    zth::usize _frame_count = 0;
+
+private:
+    void on_update() override;
+
+    void update_particles();
+    void draw_particles();
+    void print_stats();
+};
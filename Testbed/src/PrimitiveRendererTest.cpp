@@ -13,6 +13,7 @@ void PrimitiveRendererTest::sfml_primitive_renderer_test() const
 void PrimitiveRendererTest::custom_primitive_renderer_test() const
 {
     // switches between custom fill algorithms every 4 seconds
+    // switches between immediate and deferred rendering every 12 seconds
 
     auto renderer = dynamic_cast<zth::CustomPrimitiveRenderer*>(_renderer.primitive_renderer());
     assert(renderer != nullptr);
@@ -24,18 +25,42 @@ void PrimitiveRendererTest::custom_primitive_renderer_test() const
 
     if (fill_alg_timer.elapsed_s() > 4.0)
     {
-        auto alg = renderer->fill_algorithm == zth::FillAlgorithm::BoundaryFill ? zth::FillAlgorithm::FloodFill
-                                                                                : zth::FillAlgorithm::BoundaryFill;
-        renderer->fill_algorithm = alg;
+        switch (renderer->fill_algorithm)
+        {
+        case zth::FillAlgorithm::Scanline:
+            renderer->fill_algorithm = zth::FillAlgorithm::BoundaryFill;
+            break;
+        case zth::FillAlgorithm::BoundaryFill:
+            renderer->fill_algorithm = zth::FillAlgorithm::FloodFill;
+            break;
+        case zth::FillAlgorithm::FloodFill:
+            renderer->fill_algorithm = zth::FillAlgorithm::Scanline;
+            break;
+        }
         fill_alg_timer.reset();
     }
 
+    static zth::Timer render_mode_timer;
+
+    if (render_mode_timer.elapsed_s() > 12.0)
+    {
+        renderer->render_mode = renderer->render_mode == zth::RenderMode::Immediate ? zth::RenderMode::Deferred
+                                                                                    : zth::RenderMode::Immediate;
+        render_mode_timer.reset();
+    }
+
+    draw_primitives();
+}
+
+void PrimitiveRendererTest::tiled_primitive_renderer_test() const
+{
+    // should look exactly the same as the custom renderer in deferred mode with scanline fills
     draw_primitives();
 }
 
 void PrimitiveRendererTest::on_update()
 {
-    // switches between custom and sfml rendering every 2 seconds
+    // switches between sfml, custom and tiled rendering every 2 seconds
     // switches between custom fill algorithms every 4 seconds
 
     static zth::Timer renderer_type_timer;
@@ -44,9 +69,18 @@ void PrimitiveRendererTest::on_update()
 
     if (renderer_type_timer.elapsed_s() > 2.0)
     {
-        renderer_type = renderer_type == zth::PrimitiveRendererType::SfmlPrimitiveRenderer
-                            ? zth::PrimitiveRendererType::CustomPrimitiveRenderer
-                            : zth::PrimitiveRendererType::SfmlPrimitiveRenderer;
+        switch (renderer_type)
+        {
+        case zth::PrimitiveRendererType::SfmlPrimitiveRenderer:
+            renderer_type = zth::PrimitiveRendererType::CustomPrimitiveRenderer;
+            break;
+        case zth::PrimitiveRendererType::CustomPrimitiveRenderer:
+            renderer_type = zth::PrimitiveRendererType::TiledPrimitiveRenderer;
+            break;
+        case zth::PrimitiveRendererType::TiledPrimitiveRenderer:
+            renderer_type = zth::PrimitiveRendererType::SfmlPrimitiveRenderer;
+            break;
+        }
 
         zth::engine->window.renderer.set_primitive_renderer_type(renderer_type);
         renderer_type_timer.reset();
@@ -60,6 +94,9 @@ void PrimitiveRendererTest::on_update()
     case zth::PrimitiveRendererType::CustomPrimitiveRenderer:
         custom_primitive_renderer_test();
         break;
+    case zth::PrimitiveRendererType::TiledPrimitiveRenderer:
+        tiled_primitive_renderer_test();
+        break;
     }
 }
 
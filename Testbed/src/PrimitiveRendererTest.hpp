@@ -16,5 +16,6 @@ private:
 
     void sfml_primitive_renderer_test() const;
     void custom_primitive_renderer_test() const;
+    void tiled_primitive_renderer_test() const;
     void draw_primitives() const;
 };
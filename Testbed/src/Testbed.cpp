@@ -1,10 +1,13 @@
 #include "Testbed.hpp"
 
+#include "InstancedRendererTest.hpp"
 #include "PrimitiveRendererTest.hpp"
 
 #include <Zenith/Core/Engine.hpp>
 #include <Zenith/Logging/Logger.hpp>
 
+#include <cassert>
+
 static const zth::ApplicationSpec spec = {
     .window_spec = {
         .title = "Testbed",
@@ -25,7 +28,7 @@ Testbed::Testbed() : Application(spec)
     zth::logger->log_notification("On init.");
     zth::logger->log_error("Logger Test: {}, {}, {}.", 1, 2, 3);
     zth::engine->window.clear_color = zth::Color::black;
-    zth::engine->change_scene(std::make_unique<PrimitiveRendererTest>(zth::engine->window.renderer));
+    change_scene(_scene_index);
 }
 
 Testbed::~Testbed()
@@ -41,34 +44,60 @@ void Testbed::on_update()
 
 void Testbed::on_event(const zth::Event& event)
 {
-    (void)event;
     // event_test(event);
 
-    // switch (event.type())
-    // {
-    // case zth::EventType::KeyPressed:
-    // {
-    //     auto& key_event = event.key_event();
-    //     switch (key_event.key)
-    //     {
-    //     case zth::Key::A:
-    //         change_scene_back();
-    //         break;
-    //     case zth::Key::D:
-    //         change_scene_forward();
-    //         break;
-    //     }
-    // }
-    // }
+    // a and d switch between the test scenes
+    switch (event.type())
+    {
+    case zth::EventType::KeyPressed:
+    {
+        auto& key_event = event.key_event();
+        switch (key_event.key)
+        {
+        case zth::Key::A:
+            change_scene_back();
+            break;
+        case zth::Key::D:
+            change_scene_forward();
+            break;
+        default:
+            break;
+        }
+    }
+    break;
+    default:
+        break;
+    }
+}
+
+void Testbed::change_scene_back()
+{
+    change_scene((_scene_index + scene_count - 1) % scene_count);
 }
 
-// void Testbed::change_scene_back()
-// {
-// }
-// 
-// void Testbed::change_scene_forward()
-// {
-// }
+void Testbed::change_scene_forward()
+{
+    change_scene((_scene_index + 1) % scene_count);
+}
+
+void Testbed::change_scene(zth::usize scene_index)
+{
+    auto& renderer = zth::engine->window.renderer;
+    _scene_index = scene_index;
+
+    switch (_scene_index)
+    {
+    case 0:
+        zth::engine->change_scene(std::make_unique<PrimitiveRendererTest>(renderer));
+        break;
+    case 1:
+        zth::engine->change_scene(std::make_unique<InstancedRendererTest>(renderer));
+        break;
+    default:
+        assert(false);
+        break;
+    }
+}
 
 void Testbed::event_test(const zth::Event& event)
 {
@@ -12,8 +12,14 @@ private:
     void on_update() override;
     void on_event(const zth::Event& event) override;
 
-    // void change_scene_back();
-    // void change_scene_forward();
+    void change_scene_back();
+    void change_scene_forward();
+    void change_scene(zth::usize scene_index);
 
     void event_test(const zth::Event& event);
+
+private:
+    static constexpr zth::usize scene_count = 2;
+
+    zth::usize _scene_index = 0;
 };
@@ -4,7 +4,10 @@
 #include "Engine.hpp"
 #include "EventDispatcher.hpp"
 #include "EventListener.hpp"
+#include "EventQueue.hpp"
 #include "FrameCounter.hpp"
+#include "JobSystem.hpp"
+#include "Registry.hpp"
 #include "Scene.hpp"
 #include "Transformable.hpp"
 #include "Typedefs.hpp"
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
+#include "Zenith/Core/EventQueue.hpp"
 #include "Zenith/Core/FrameCounter.hpp"
+#include "Zenith/Core/JobSystem.hpp"
 #include "Zenith/Core/Scene.hpp"
 #include "Zenith/Platform/Event.hpp"
 #include "Zenith/Platform/Input/Input.hpp"
@@ -18,6 +21,8 @@ class EventListener;
 class Engine
 {
 public:
+    // declared first, so that it outlives everything which could be using it
+    JobSystem job_system;
     Window window;
     Input input;
     std::unique_ptr<Scene> scene;
@@ -28,6 +33,8 @@ public:
 
     auto delta_time() const { return _delta_time; }
     auto fps() const { return _frame_counter.get_fps(); }
+    // the events of the current frame, in the order they happened in, can be consumed as a whole during the update
+    std::span<const Event> events() const { return _event_queue.events(); }
 
     // changes the scene in the next frame
     void change_scene(std::unique_ptr<Scene> new_scene);
@@ -38,6 +45,7 @@ public:
 private:
     double _delta_time = 0.0;
     FrameCounter _frame_counter;
+    EventQueue _event_queue;
     std::unique_ptr<Scene> _queued_scene;
 
 private:
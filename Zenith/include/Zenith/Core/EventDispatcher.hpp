@@ -1,25 +1,36 @@
 #pragma once
 
-#include <unordered_map>
+#include <array>
 #include <vector>
 
+#include "Zenith/Core/Typedefs.hpp"
 #include "Zenith/Platform/Event.hpp"
 
 namespace zth {
 
 class EventListener;
 
+// listeners can be registered and deregistered while an event is being dispatched, the ones registered meanwhile
+// first receive the next event, the ones deregistered meanwhile don't receive any more events
 class EventDispatcher
 {
 public:
-    void register_listener(EventListener& listener);
+    void register_listener(EventListener& listener, EventTypeFlags event_types = EventTypeFlags::All);
     void register_listener(EventType event_type, EventListener& listener);
     void deregister_listener(EventType event_type, const EventListener& listener);
-    void deregister_listener(const EventListener& listener);
+    void deregister_listener(const EventListener& listener, EventTypeFlags event_types = EventTypeFlags::All);
     void dispatch(const Event& event);
 
 private:
-    std::unordered_map<EventType, std::vector<EventListener*>> _listeners_map;
+    // indexed by event type, the listeners of every event type in the order they were registered in
+    std::array<std::vector<EventListener*>, event_type_enumerations.size()> _listeners;
+
+    // listeners deregistered during a dispatch are set to null and erased once it's over
+    usize _dispatch_depth = 0;
+    bool _has_deregistered_listeners = false;
+
+private:
+    std::vector<EventListener*>& get_listeners(EventType event_type);
 };
 
 } // namespace zth
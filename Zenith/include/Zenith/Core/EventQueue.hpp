@@ -0,0 +1,31 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Platform/Event.hpp"
+
+namespace zth {
+
+// collects the events of a single frame, so that they can be dispatched and consumed as one batch
+// consecutive events which only carry the latest state of something get collapsed into the last one of them
+class EventQueue
+{
+public:
+    void push(const Event& event);
+    void clear();
+
+    std::span<const Event> events() const { return _events; }
+
+    auto size() const { return _events.size(); }
+    auto empty() const { return _events.empty(); }
+    // the events collapsed into later ones since the last clear
+    auto coalesced_count() const { return _coalesced_count; }
+
+private:
+    std::vector<Event> _events;
+    usize _coalesced_count = 0;
+};
+
+} // namespace zth
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+class JobCounter;
+
+struct Job
+{
+    std::function<void()> function;
+    JobCounter* counter;
+};
+
+// counts the unfinished jobs started with it, so that they can be waited on or depended on
+// a counter can be reused once it's done, but it mustn't be destroyed before JobSystem::wait() returns for it
+class JobCounter
+{
+public:
+    explicit JobCounter() = default;
+    ZTH_NO_COPY_NO_MOVE(JobCounter)
+
+    ~JobCounter() = default;
+
+    bool is_done() const { return _count.load(std::memory_order_acquire) == 0; }
+
+    friend class JobSystem;
+
+private:
+    std::atomic<usize> _count = 0;
+    std::mutex _mutex;
+    std::vector<Job*> _continuations; // jobs depending on this counter, started once it gets to 0
+};
+
+// a chase-lev deque of jobs, only the thread owning it can push and pop at the bottom,
+// any other thread can steal from the top
+class WorkStealingQueue
+{
+public:
+    static constexpr usize capacity = 4096;
+    static_assert(std::has_single_bit(capacity));
+
+public:
+    explicit WorkStealingQueue() = default;
+    ZTH_NO_COPY_NO_MOVE(WorkStealingQueue)
+
+    ~WorkStealingQueue() = default;
+
+    // fails if the queue is full
+    bool push(Job* job);
+    Job* pop();
+    Job* steal();
+
+private:
+    alignas(64) std::atomic<i64> _top = 0;
+    alignas(64) std::atomic<i64> _bottom = 0;
+    alignas(64) std::array<std::atomic<Job*>, capacity> _jobs{};
+};
+
+// runs jobs on a worker thread per core, every thread has its own queue and steals from the others when it runs out
+// jobs can only be started from the thread which created the job system or from inside of other jobs
+class JobSystem
+{
+public:
+    // the thread creating the job system is counted in, as it runs jobs while waiting for them
+    explicit JobSystem(usize thread_count = std::max(std::thread::hardware_concurrency(), 1u));
+    ZTH_NO_COPY_NO_MOVE(JobSystem)
+
+    ~JobSystem();
+
+    void run(std::function<void()> function, JobCounter& counter);
+    // the job gets started once the dependency is done
+    void run_after(JobCounter& dependency, std::function<void()> function, JobCounter& counter);
+
+    // runs other jobs until the counter is done
+    void wait(JobCounter& counter);
+
+    // calls function(index) for every index in [0, count) and waits for all of them
+    // indices get split into batches of at least min_batch_size, so that small loops don't pay for the jobs
+    template<typename Function> void parallel_for(usize count, Function&& function, usize min_batch_size = 1);
+
+    // calls function(item) for every item and waits for all of them
+    template<typename T, typename Function>
+    void parallel_for(std::span<T> items, Function&& function, usize min_batch_size = 1)
+    {
+        parallel_for(items.size(), [&](usize index) { function(items[index]); }, min_batch_size);
+    }
+
+    usize thread_count() const { return _queues.size(); }
+
+private:
+    std::vector<std::unique_ptr<WorkStealingQueue>> _queues; // the first one belongs to the creating thread
+    std::atomic<usize> _queued_job_count = 0;
+
+    std::mutex _mutex;
+    std::condition_variable_any _job_queued;
+    std::atomic<usize> _sleeping_worker_count = 0;
+
+    // declared last, so that the workers get stopped and joined before anything they use is destroyed
+    std::vector<std::jthread> _workers;
+
+private:
+    void push(Job* job);
+    Job* find_job();
+    void execute(Job* job);
+    void finish(JobCounter& counter);
+
+    void worker_loop(std::stop_token stop_token, usize queue_index);
+};
+
+template<typename Function> void JobSystem::parallel_for(usize count, Function&& function, usize min_batch_size)
+{
+    // a few batches per thread leave room for stealing when some of them take longer than others
+    constexpr usize batches_per_thread = 4;
+
+    const auto max_batch_count = thread_count() * batches_per_thread;
+    const auto batch_count = std::min(count / std::max(min_batch_size, usize{ 1 }), max_batch_count);
+
+    if (batch_count <= 1)
+    {
+        for (usize index = 0; index < count; index++)
+            function(index);
+
+        return;
+    }
+
+    JobCounter counter;
+
+    for (usize batch = 0; batch < batch_count; batch++)
+    {
+        const auto begin = count * batch / batch_count;
+        const auto end = count * (batch + 1) / batch_count;
+
+        run(
+            [&function, begin, end] {
+                for (auto index = begin; index < end; index++)
+                    function(index);
+            },
+            counter);
+    }
+
+    wait(counter);
+}
+
+} // namespace zth
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Zenith/Core/JobSystem.hpp"
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Utility/SlotMap.hpp"
+
+namespace zth {
+
+// the objects registered with a scene, which can be added and removed while they're being iterated over
+// objects are iterated over in the order they were added in, objects added during an iteration are first visited by
+// the next one, objects removed during an iteration aren't visited anymore
+// removed objects are erased all at once before the objects are next iterated over or looked at, which keeps the
+// order of the rest without moving them on every removal
+// objects mustn't be added or removed from other threads during a parallel iteration
+template<typename T> class Registry
+{
+public:
+    using Handle = SlotMap<T*>::Handle;
+
+public:
+    Handle add(T& object) { return _objects.insert(&object); }
+
+    void remove(Handle handle)
+    {
+        if (auto object = _objects.get(handle); object && *object)
+        {
+            *object = nullptr;
+            _pending_removals.push_back(handle);
+        }
+    }
+
+    T* get(Handle handle) const
+    {
+        auto object = _objects.get(handle);
+        return object ? *object : nullptr;
+    }
+
+    template<typename Function> void for_each(Function&& function)
+    {
+        apply_pending_removals();
+        _is_iterating = true;
+
+        // objects added meanwhile are appended past the ones which were there when the iteration started
+        const auto count = _objects.size();
+
+        for (usize i = 0; i < count; i++)
+        {
+            if (auto object = _objects.values()[i])
+                function(*object);
+        }
+
+        _is_iterating = false;
+    }
+
+    template<typename Function>
+    void parallel_for_each(JobSystem& job_system, Function&& function, usize min_batch_size = 1)
+    {
+        apply_pending_removals();
+        _is_iterating = true;
+
+        job_system.parallel_for(
+            _objects.values(),
+            [&](T* object) {
+                if (object)
+                    function(*object);
+            },
+            min_batch_size);
+
+        _is_iterating = false;
+    }
+
+    // only contains removed objects, as null pointers, when called during an iteration
+    std::span<T* const> objects()
+    {
+        apply_pending_removals();
+        return _objects.values();
+    }
+
+    auto size() const { return _objects.size() - _pending_removals.size(); }
+
+private:
+    SlotMap<T*> _objects;
+    std::vector<Handle> _pending_removals;
+    bool _is_iterating = false;
+
+private:
+    void apply_pending_removals()
+    {
+        // erasing during an iteration would move the objects which haven't been visited yet
+        if (_is_iterating || _pending_removals.empty())
+            return;
+
+        _objects.erase(_pending_removals);
+        _pending_removals.clear();
+    }
+};
+
+} // namespace zth
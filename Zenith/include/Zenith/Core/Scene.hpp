@@ -1,7 +1,14 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "Zenith/Core/EventDispatcher.hpp"
+#include "Zenith/Core/Registry.hpp"
+#include "Zenith/Core/Typedefs.hpp"
 #include "Zenith/Core/Updater.hpp"
+#include "Zenith/Graphics/LayerCache.hpp"
+#include "Zenith/Graphics/RenderQueue.hpp"
 #include "Zenith/Utility/Utility.hpp"
 
 namespace zth {
@@ -9,41 +16,85 @@ namespace zth {
 class Drawable;
 class Animatable;
 
+using DrawableHandle = Registry<Drawable>::Handle;
+using AnimatableHandle = Registry<Animatable>::Handle;
+
+struct CullingStats
+{
+    usize drawn_count;
+    usize culled_count;
+    usize cached_count; // drawables on static layers, drawn as part of their layer's cache
+};
+
 class Scene
 {
+public:
+    // drawables whose bounds lie entirely outside of the view don't get drawn
+    bool cull_drawables = true;
+
 public:
     virtual ~Scene() = default;
     ZTH_NO_COPY_NO_MOVE(Scene)
 
+    // the stats of the last drawn frame
+    const auto& culling_stats() const { return _culling_stats; }
+
     friend class Engine;
 
 protected:
     explicit Scene() = default;
 
-    void register_updatable(Updatable& updatable);
-    void deregister_updatable(const Updatable& updatable);
+    // registering returns a handle, which is what the object gets deregistered with
+    // objects can be registered and deregistered at any point of the update, except from parallel updatables
+    UpdatableHandle register_updatable(Updatable& updatable, UpdatePhase update_phase = UpdatePhase::Serial);
+    void deregister_updatable(const UpdatableHandle& handle);
     
-    void register_event_listener(EventListener& listener);
+    void register_event_listener(EventListener& listener, EventTypeFlags event_types = EventTypeFlags::All);
     void register_event_listener(EventType event_type, EventListener& listener);
     void deregister_event_listener(EventType event_type, const EventListener& listener);
-    void deregister_event_listener(const EventListener& listener);
+    void deregister_event_listener(const EventListener& listener, EventTypeFlags event_types = EventTypeFlags::All);
+
+    DrawableHandle register_drawable(Drawable& drawable);
+    void deregister_drawable(DrawableHandle handle);
 
-    void register_drawable(Drawable& drawable);
-    void deregister_drawable(Drawable& drawable);
+    AnimatableHandle register_animatable(Animatable& animatable);
+    void deregister_animatable(AnimatableHandle handle);
 
-    void register_animatable(Animatable& animatable);
-    void deregister_animatable(Animatable& animatable);
+    // the drawables on a static layer are drawn into a texture once, which is then drawn in their place every frame
+    // the layer has to be invalidated whenever any of its drawables changes, so that the texture gets redrawn
+    void set_layer_static(u16 layer, bool is_static = true);
+    bool is_layer_static(u16 layer) const;
+    void invalidate_layer(u16 layer);
+
+    // the drawables on a grouped layer are drawn grouped by shader and texture, which saves state changes, but the
+    // order of drawables with different ones is then decided by the grouping instead of their depths (see RenderQueue)
+    void set_layer_grouped(u16 layer, bool is_grouped = true);
+    bool is_layer_grouped(u16 layer) const;
 
 private:
+    enum class DrawableVisibility : u8
+    {
+        Visible,
+        Culled,
+        Cached, // drawn as part of its layer's cache
+    };
+
     Updater _updater;
     EventDispatcher _event_dispatcher;
-    std::vector<Drawable*> _drawables;
-    std::vector<Animatable*> _animatables;
+    Registry<Drawable> _drawables;
+    std::vector<DrawableVisibility> _drawable_visibilities; // of the drawables in the current frame
+    RenderQueue _render_queue;
+    CullingStats _culling_stats{ .drawn_count = 0, .culled_count = 0, .cached_count = 0 };
+    std::vector<std::unique_ptr<LayerCache>> _layer_caches;
+    Registry<Animatable> _animatables;
 
 private:
     void update();
     void dispatch_event(const Event& event);
 
+    DrawableVisibility get_visibility(const Drawable& drawable, const Rect& view_bounds) const;
+    LayerCache* find_layer_cache(u16 layer) const;
+
     virtual void on_load() {}
     virtual void on_update() {}
     virtual void on_event([[maybe_unused]] const Event& event) {}
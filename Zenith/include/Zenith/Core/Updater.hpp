@@ -1,20 +1,41 @@
 #pragma once
 
-#include <vector>
+#include "Zenith/Core/Registry.hpp"
+#include "Zenith/Core/Typedefs.hpp"
 
 namespace zth {
 
+class JobSystem;
 class Updatable;
 
+enum class UpdatePhase : u8
+{
+    Parallel, // updated on worker threads, mustn't touch global engine state or other updatables
+    Serial,   // updated on the main thread, after every parallel updatable has been updated
+};
+
+const char* to_string(UpdatePhase update_phase);
+
+struct UpdatableHandle
+{
+    Registry<Updatable>::Handle handle{};
+    UpdatePhase update_phase = UpdatePhase::Serial;
+};
+
 class Updater
 {
 public:
-    void register_updatable(Updatable& updatable);
-    void deregister_updatable(const Updatable& updatable);
-    void update() const;
+    UpdatableHandle register_updatable(Updatable& updatable, UpdatePhase update_phase = UpdatePhase::Serial);
+    // can be called from serial updatables, the updatable won't get updated anymore
+    void deregister_updatable(const UpdatableHandle& handle);
+    void update(JobSystem& job_system);
+
+private:
+    Registry<Updatable> _parallel_updatables;
+    Registry<Updatable> _serial_updatables;
 
 private:
-    std::vector<Updatable*> _updatables;
+    Registry<Updatable>& get_registry(UpdatePhase update_phase);
 };
 
 } // namespace zth
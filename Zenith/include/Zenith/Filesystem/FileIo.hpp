@@ -2,13 +2,17 @@
 
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string_view>
 
+#include "Zenith/Core/Typedefs.hpp"
+
 namespace zth {
 
 std::optional<std::stringstream> read_from_file(const std::filesystem::path& path);
 bool write_to_file(const std::filesystem::path& path, std::string_view content);
+bool write_to_file(const std::filesystem::path& path, std::span<const u8> content); // writes the bytes as they are
 bool append_to_file(const std::filesystem::path& path, std::string_view content);
 bool append_to_file_with_newline(const std::filesystem::path& path, std::string_view content);
 
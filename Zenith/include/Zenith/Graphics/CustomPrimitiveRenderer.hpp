@@ -1,11 +1,17 @@
 #pragma once
 
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
 
+#include <optional>
 #include <span>
+#include <vector>
 
+#include "Zenith/Core/Typedefs.hpp"
 #include "Zenith/Graphics/Color.hpp"
+#include "Zenith/Graphics/Framebuffer.hpp"
 #include "Zenith/Graphics/PrimitiveRenderer.hpp"
+#include "Zenith/Graphics/ShapeMaskCache.hpp"
 #include "Zenith/Graphics/VertexArray.hpp"
 #include "Zenith/Math/Geometry.hpp"
 #include "Zenith/Math/Vec2.hpp"
@@ -13,25 +19,77 @@
 
 namespace zth {
 
+class ImageRasterizer;
+
 enum class FillAlgorithm
 {
+    Scanline, // fills the shape one horizontal span per row, straight from its edges
     BoundaryFill,
     FloodFill,
 };
 
+enum class RenderMode
+{
+    Immediate, // every primitive is drawn to the render target as soon as it's rasterized
+    Deferred,  // primitives are rasterized into a framebuffer which gets drawn once per frame on flush
+};
+
+enum class PixelOutput
+{
+    Points, // every plotted pixel is sent to the render target as a separate point
+    Spans,  // runs of same-colored pixels on a row are merged into horizontal lines
+};
+
 // TODO: Refactor this class
 class CustomPrimitiveRenderer : public PrimitiveRenderer
 {
 public:
-    FillAlgorithm fill_algorithm = FillAlgorithm::FloodFill;
+    FillAlgorithm fill_algorithm = FillAlgorithm::Scanline;
+    RenderMode render_mode = RenderMode::Immediate;
+    PixelOutput pixel_output = PixelOutput::Spans; // only used in immediate mode
+    ShapeMaskCache shape_mask_cache; // off by default, filled shapes are drawn from cached masks once turned on
 
 public:
     explicit CustomPrimitiveRenderer(sf::RenderTarget& render_target) : PrimitiveRenderer(render_target) {}
+    // renders headlessly, straight into the framebuffer, always as if in deferred mode
+    // the framebuffer doesn't get cleared on flush, so it keeps its contents until cleared explicitly
+    explicit CustomPrimitiveRenderer(Framebuffer& framebuffer) : _target_framebuffer(&framebuffer) {}
     ~CustomPrimitiveRenderer() override = default;
     ZTH_NO_COPY_NO_MOVE(CustomPrimitiveRenderer)
 
 private:
+    enum class FilledShapeType : u8
+    {
+        Triangle,
+        Rect,
+        ConvexPolygon,
+        ConvexPolygonLines,
+        Circle,
+        Ellipse,
+    };
+
+    struct PlottedPixel
+    {
+        Vec2i position;
+        Color color;
+    };
+
     VertexArray _vertex_array{ PrimitiveType::Points }; // we're only ever drawing points in custom renderer
+    VertexArray _span_vertex_array{ PrimitiveType::Lines };
+    std::vector<PlottedPixel> _plotted_pixels; // pixels waiting to be merged into spans
+    sf::Image _tmp_image;     // reused for rasterizing every shape which can't be drawn straight to the target
+    // textures are opengl resources, creating one sets up an opengl context, which needs a display, so they're only
+    // created once there's something to upload, which a headless renderer never has
+    std::optional<sf::Texture> _tmp_texture; // reused for uploading every rasterized image, only ever grows
+    sf::Image _framebuffer;
+    std::optional<sf::Texture> _framebuffer_texture;
+    bool _framebuffer_in_use = false;
+    Framebuffer* _target_framebuffer = nullptr; // set when rendering headlessly
+    std::vector<Vec2i> _fill_stack; // reused by every seed fill, only ever grows
+    std::vector<Vec2f> _local_points; // reused for translating the points of every filled polygon
+    std::vector<Line> _local_lines;   // reused for translating the lines of every filled polygon
+    std::vector<float> _mask_key; // reused for building the key of every cached shape
+    ShapeMask _shape_mask;        // the most recently created mask
 
 private:
     void draw_point_impl(const Vec2f& point, const Color& color) override;
@@ -59,6 +117,8 @@ private:
     void draw_filled_circle_impl(const Circle& circle, const Color& color) override;
     void draw_filled_ellipse_impl(const Ellipse& ellipse, const Color& color) override;
 
+    void flush_impl() override;
+
     void plot_point(const Vec2f& point, const Color& color);
     void plot_points(std::span<const Vec2f> points, const Color& color);
     void plot_line(const Vec2f& from, const Vec2f& to, const Color& color);
@@ -78,34 +138,41 @@ private:
     void plot_circle(const Circle& circle, const Color& color);
     void plot_ellipse(const Ellipse& ellipse, const Color& color);
 
-    static void draw_line_on_image(sf::Image& image, const Vec2f& from, const Vec2f& to, const Color& color);
-    static void draw_line_on_image(sf::Image& image, const Line& line, const Color& color);
-    static void draw_line_strip_on_image(sf::Image& image, std::span<const Vec2f> points, const Color& color);
-    static void draw_lines_on_image(sf::Image& image, std::span<const Line> lines, const Color& color);
-    static void draw_triangle_on_image(sf::Image& image, const Triangle& triangle, const Color& color);
-    static void draw_rect_on_image(sf::Image& image, const Rect& rect, const Color& color);
-    static void draw_circle_on_image(sf::Image& image, const Circle& circle, const Color& color);
-    static void draw_ellipse_on_image(sf::Image& image, const Ellipse& ellipse, const Color& color);
-
-    static Vec2u get_triangle_seed(const Triangle& triangle);
-    static Vec2u get_rect_seed(const Rect& rect);
-    static Vec2u get_convex_polygon_seed(std::span<const Vec2f> points);
-    static Vec2u get_convex_polygon_seed(std::span<const Line> lines);
-    static Vec2u get_circle_seed(const Circle& circle);
-    static Vec2u get_ellipse_seed(const Ellipse& ellipse);
-
-    static void boundary_fill_on_image(sf::Image& image, const Vec2u& seed, const Color& border_color,
-                                       const Color& fill_color);
-    static void flood_fill_on_image(sf::Image& image, const Vec2u& seed, const Color& fill_color,
-                                    const Color& background_color);
-
-    void fill_on_image(sf::Image& image, const Vec2u& seed, const Color& border_color, const Color& fill_color,
-                       const Color& background_color) const;
-    void draw_image(const sf::Image& image) const;
-
-    static sf::Image& get_tmp_image(const sf::Vector2u& target_size);
+    static Rect get_convex_polygon_bounds(std::span<const Vec2f> points);
+    static Rect get_convex_polygon_bounds(std::span<const Line> lines);
+
+    static Vec2i get_triangle_seed(const Triangle& triangle);
+    static Vec2i get_rect_seed(const Rect& rect);
+    static Vec2i get_convex_polygon_seed(std::span<const Vec2f> points);
+    static Vec2i get_convex_polygon_seed(std::span<const Line> lines);
+    static Vec2i get_circle_seed(const Circle& circle);
+    static Vec2i get_ellipse_seed(const Ellipse& ellipse);
+
+    void fill_on_image(sf::Image& image, const Vec2i& seed, const Color& border_color, const Color& fill_color,
+                       const Color& background_color);
+    template<typename GetMaskKeyFn, typename RasterizeFn>
+    void draw_filled_shape(const Rect& bounds, FilledShapeType shape_type, const Color& color,
+                           GetMaskKeyFn&& get_mask_key, RasterizeFn&& rasterize);
+    void draw_shape_mask(const ShapeMask& mask, const Vec2i& position, const Color& color);
+    void draw_shape_image(const sf::Image& image, const Vec2i& position);
+
+    bool is_within_target(const Rect& bounds) const;
+
+    // returns the pixels covered by the bounds, clipped to the render target
+    std::optional<IntRect> get_raster_bounds(const Rect& bounds) const;
+    void draw_image(const sf::Image& image, const Vec2i& position);
+
+    RenderMode get_render_mode() const;
+    Vec2u get_target_size() const;
+
+    sf::Image& get_framebuffer();
+    sf::Image& get_tmp_image(const IntRect& raster_bounds);
+    ImageRasterizer get_rasterizer(sf::Image& image);
 
     void draw_call();
+    void draw_spans();
+    void append_span(const Vec2i& start, i32 length, const Color& color);
+    void draw_span_vertices();
 };
 
 } // namespace zth
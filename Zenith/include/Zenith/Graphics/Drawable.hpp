@@ -1,15 +1,34 @@
 #pragma once
 
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/RenderQueue.hpp"
+#include "Zenith/Math/Geometry.hpp"
+
 namespace zth {
 
 class Renderer;
 
 class Drawable
 {
+public:
+    // drawables of a scene are drawn from the lowest layer to the highest one, depth orders the drawables within a
+    // layer, and drawables with the same depth are drawn in the order they were registered in
+    // on layers grouped by shader and texture depth only orders the drawables which share them (see RenderQueue)
+    u16 layer = 0;
+    u16 depth = 0;
+
 public:
     virtual ~Drawable() = default;
 
     virtual void draw(Renderer& renderer) const = 0;
+    // the axis-aligned bounds in world coordinates, used to skip drawables which are out of view
+    // the scene culls drawables in parallel, so this gets called from worker threads and has to be thread-safe
+    virtual Rect bounds() const = 0;
+
+    virtual void submit(RenderQueue& render_queue) const
+    {
+        render_queue.submit(*this, { .layer = layer, .shader = nullptr, .texture = nullptr, .depth = depth });
+    }
 };
 
 } // namespace zth
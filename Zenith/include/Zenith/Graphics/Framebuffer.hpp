@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <filesystem>
+#include <span>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Color.hpp"
+#include "Zenith/Math/Vec2.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+// a render target living entirely in system memory, it doesn't need a window nor an OpenGL context, so it can be
+// used for offscreen rendering on machines without a gpu or a display
+// the pixels are tightly packed RGBA8, stored row by row starting from the top
+class Framebuffer
+{
+public:
+    explicit Framebuffer() = default;
+    explicit Framebuffer(const Vec2u& size, const Color& color = Color::transparent);
+    ZTH_DEFAULT_COPY_DEFAULT_MOVE(Framebuffer)
+
+    ~Framebuffer() = default;
+
+    void create(const Vec2u& size, const Color& color = Color::transparent);
+    void clear(const Color& color);
+
+    auto width() const { return _image.getSize().x; }
+    auto height() const { return _image.getSize().y; }
+    auto size() const { return Vec2u{ _image.getSize() }; }
+
+    Color get_pixel(u32 x, u32 y) const;
+    std::span<const u8> pixels() const;
+
+    // the format is deduced from the extension (png, bmp, tga or jpg)
+    bool save_to_file(const std::filesystem::path& path) const;
+    // writes the pixels as they are in memory, without any header
+    bool save_raw(const std::filesystem::path& path) const;
+
+    friend class CustomPrimitiveRenderer;
+
+private:
+    sf::Image _image;
+};
+
+} // namespace zth
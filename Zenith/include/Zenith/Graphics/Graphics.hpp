@@ -4,15 +4,27 @@
 #include "Color.hpp"
 #include "CustomPrimitiveRenderer.hpp"
 #include "Drawable.hpp"
+#include "Framebuffer.hpp"
+#include "InstancedRenderer.hpp"
+#include "LayerCache.hpp"
 #include "OpenGlContextSettings.hpp"
+#include "PixelKernels.hpp"
 #include "PrimitiveRenderer.hpp"
+#include "Rasterizer.hpp"
+#include "RenderQueue.hpp"
 #include "Renderer.hpp"
 #include "SfmlEllipseShape.hpp"
 #include "SfmlPrimitiveRenderer.hpp"
 #include "Shader.hpp"
 #include "Shaders.hpp"
+#include "ShapeMaskCache.hpp"
 #include "Shapes/Shapes.hpp"
 #include "Sprite.hpp"
+#include "SpriteBatch.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
+#include "TiledPrimitiveRenderer.hpp"
+#include "UnitCircleCache.hpp"
 #include "Vertex.hpp"
 #include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <array>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Color.hpp"
+#include "Zenith/Graphics/Shader.hpp"
+#include "Zenith/Graphics/UnitCircleCache.hpp"
+#include "Zenith/Math/Geometry.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+class Sprite;
+
+enum class InstanceKind : u8
+{
+    Rect,
+    Circle,
+    Sprite,
+};
+
+const char* to_string(InstanceKind instance_kind);
+
+// the attributes of a single instance, laid out the same as in the instance buffer
+struct InstanceData
+{
+    // the rows of the affine transform from the unit square to world space
+    std::array<float, 3> transform_x;
+    std::array<float, 3> transform_y;
+    Color color;
+    std::array<float, 4> uv_rect; // left, top, width, height, in texture pixels
+};
+
+// draws rects, circles and sprites as instances of the unit square, so that every shape takes up a single entry in
+// the instance buffer instead of its own vertices, and a whole batch gets drawn with one draw call
+// every kind of instance has its own shader, a new batch starts whenever the kind or the texture changes
+// instancing needs OpenGL 3.3 or the ARB_instanced_arrays extension, without it the instances are expanded into
+// vertices on the cpu and drawn through sfml
+class InstancedRenderer
+{
+public:
+    explicit InstancedRenderer(sf::RenderTarget& render_target) : _render_target(&render_target) {}
+    ZTH_NO_COPY_NO_MOVE(InstancedRenderer)
+
+    ~InstancedRenderer();
+
+    void draw_rect(const Rect& rect, const Color& color);
+    void draw_circle(const Circle& circle, const Color& color);
+    void draw_sprite(const Sprite& sprite);
+
+    // draws every instance submitted since the last flush
+    void flush();
+
+    // flushes into the current render target first
+    void set_render_target(sf::RenderTarget& render_target);
+
+    // initializes the OpenGL objects the first time it's called, so it needs an active context
+    bool is_available();
+
+    u64 draw_call_count() const { return _draw_call_count; }
+    u64 instance_count() const { return _instance_count; }
+    void reset_counters();
+
+private:
+    enum class State : u8
+    {
+        Uninitialized,
+        Available,
+        Unavailable,
+    };
+
+    struct InstanceShader
+    {
+        Shader* shader = nullptr;
+        std::array<i32, 5> attribute_locations;
+    };
+
+    sf::RenderTarget* _render_target;
+    State _state = State::Uninitialized;
+
+    std::array<InstanceShader, 3> _shaders;
+    u32 _corner_buffer = 0;
+    u32 _instance_buffer = 0;
+
+    InstanceKind _batch_kind = InstanceKind::Rect;
+    const sf::Texture* _batch_texture = nullptr;
+    std::vector<InstanceData> _instances;
+
+    std::vector<sf::Vertex> _fallback_vertices;
+    UnitCircleCache _unit_circle_cache;
+
+    u64 _draw_call_count = 0;
+    u64 _instance_count = 0;
+
+private:
+    void add_instance(InstanceKind kind, const sf::Texture* texture, const InstanceData& instance);
+
+    bool init();
+    void draw_instanced();
+    void draw_expanded();
+};
+
+} // namespace zth
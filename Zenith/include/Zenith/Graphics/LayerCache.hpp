@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <span>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Drawable.hpp"
+#include "Zenith/Graphics/RenderQueue.hpp"
+#include "Zenith/Math/Geometry.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+// the drawables of a single layer rendered into a texture, which then gets drawn in their place as one quad
+// the texture covers some padding around the view, so the view can scroll within it without the cache being redrawn
+// the cache has to be redrawn when invalidated, when the view leaves the padded area, or when the zoom, rotation or
+// viewport of the view, or the size of the render target changes
+class LayerCache : public Drawable
+{
+public:
+    static constexpr float default_padding = 0.25f;
+
+public:
+    explicit LayerCache(u16 cached_layer) { layer = cached_layer; }
+    ZTH_NO_COPY_NO_MOVE(LayerCache)
+
+    ~LayerCache() override = default;
+
+    void draw(Renderer& renderer) const override;
+    // the part of the world the cache covers, including the padding
+    Rect bounds() const override { return _bounds; }
+
+    void invalidate() { _is_valid = false; }
+    // whether the drawables get grouped by shader and texture when redrawn, see RenderQueue
+    void set_grouped(bool is_grouped);
+    // the padding on every side, as a fraction of the view's size
+    // more padding means fewer redraws while scrolling, but a bigger texture to redraw
+    void set_padding(float padding);
+    float padding() const { return _padding; }
+    bool is_valid() const { return _is_valid; }
+    // whether the cached texture can be drawn to the render target as it is
+    bool is_up_to_date(const sf::RenderTarget& render_target) const;
+
+    // draws the drawables on the cached layer into the texture, with the view of the renderer's render target widened
+    // by the padding, the cache stays invalid if the texture couldn't be created
+    void redraw(Renderer& renderer, std::span<Drawable* const> drawables, bool cull_drawables);
+
+    usize redraw_count() const { return _redraw_count; }
+
+    friend class Renderer;
+
+private:
+    sf::RenderTexture _render_texture;
+    RenderQueue _render_queue;
+    sf::View _view;        // the padded view the texture was drawn with
+    sf::View _target_view; // the view of the render target when the cache was drawn
+    sf::Vector2u _target_size;
+    float _padding = default_padding;
+    Rect _bounds{};
+    bool _is_valid = false;
+    usize _redraw_count = 0;
+
+private:
+    void draw_to(sf::RenderTarget& render_target) const;
+};
+
+} // namespace zth
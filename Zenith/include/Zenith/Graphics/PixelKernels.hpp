@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Color.hpp"
+
+namespace zth {
+
+// kernels working on rows of tightly packed RGBA8 pixels
+// the best implementation supported by the cpu gets picked once at runtime
+
+inline constexpr usize bytes_per_pixel = 4;
+
+enum class PixelKernelSet
+{
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// sets every pixel to the given color
+void fill_pixels(u8* pixels, usize pixel_count, const Color& color);
+void copy_pixels(u8* destination, const u8* source, usize pixel_count);
+// composes the source over the destination, the same way sf::Image::copy does when applying alpha
+void blend_pixels(u8* destination, const u8* source, usize pixel_count);
+// composes the color over every pixel, the same as blend_pixels with a source made up of just the color
+void blend_color(u8* pixels, usize pixel_count, const Color& color);
+
+PixelKernelSet get_pixel_kernel_set();
+const char* to_string(PixelKernelSet pixel_kernel_set);
+
+} // namespace zth
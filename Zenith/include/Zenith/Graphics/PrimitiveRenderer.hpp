@@ -15,7 +15,7 @@ namespace zth {
 class PrimitiveRenderer
 {
 public:
-    explicit PrimitiveRenderer(sf::RenderTarget& render_target) : _render_target(render_target) {}
+    explicit PrimitiveRenderer(sf::RenderTarget& render_target) : _render_target(&render_target) {}
     virtual ~PrimitiveRenderer() = default;
     ZTH_NO_COPY_NO_MOVE(PrimitiveRenderer)
 
@@ -44,8 +44,18 @@ public:
     void draw_filled_circle(const Circle& circle, const Color& color);
     void draw_filled_ellipse(const Ellipse& ellipse, const Color& color);
 
+    // draws everything that the renderer has been holding on to, should be called at the end of every frame
+    void flush();
+
+    // flushes into the current render target first, shouldn't be called on headless renderers
+    void set_render_target(sf::RenderTarget& render_target);
+
 protected:
-    sf::RenderTarget& _render_target;
+    sf::RenderTarget* _render_target = nullptr; // null for headless renderers
+
+protected:
+    // headless renderers don't draw to a render target at all
+    explicit PrimitiveRenderer() = default;
 
 private:
     virtual void draw_point_impl(const Vec2f& point, const Color& color) = 0;
@@ -72,6 +82,8 @@ private:
     virtual void draw_ellipse_impl(const Ellipse& ellipse, const Color& color) = 0;
     virtual void draw_filled_circle_impl(const Circle& circle, const Color& color) = 0;
     virtual void draw_filled_ellipse_impl(const Ellipse& ellipse, const Color& color) = 0;
+
+    virtual void flush_impl() {}
 };
 
 } // namespace zth
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Color.hpp"
+#include "Zenith/Math/Geometry.hpp"
+#include "Zenith/Math/Vec2.hpp"
+
+namespace zth {
+
+struct PixelLine
+{
+    Vec2i from;
+    Vec2i to;
+};
+
+// clips the line to the [0, size) area using the Liang-Barsky algorithm and snaps the clipped end points to pixels,
+// returns nothing if no part of the line lies within the area
+std::optional<PixelLine> clip_line(const Vec2f& from, const Vec2f& to, const Vec2u& size);
+
+// returns the pixels covered by the bounds, clipped to the [0, size) area
+std::optional<IntRect> get_raster_bounds(const Rect& bounds, const Vec2u& size);
+
+Vec2i to_pixel(const Vec2f& point);
+i32 to_pixel_radius(float radius);
+
+// composes the source over the destination, with the top-left corner of the source at the given position
+// the source has to fit within the destination
+void blend_image(sf::Image& destination, const sf::Image& source, const Vec2i& position);
+
+template<typename PlotFn> void bresenham_line(const PixelLine& line, PlotFn&& plot);
+template<typename PlotFn> void midpoint_circle(const Vec2i& center, i32 radius, PlotFn&& plot);
+template<typename PlotFn> void midpoint_ellipse(const Vec2i& center, const Vec2i& radius, PlotFn&& plot);
+
+// draws primitives straight into an image, only ever touching the pixels within the clip rect
+// the pixels a primitive covers don't depend on the clip rect, so an image drawn in parts (e.g. tile by tile) comes
+// out the same as one drawn in one go
+class ImageRasterizer
+{
+public:
+    // translucent colors get composed over the pixels already in the image instead of replacing them
+    // images which get blended somewhere else later on, or get seed filled, need the colors to be written as they are
+    bool blend = false;
+
+public:
+    explicit ImageRasterizer(sf::Image& image);
+    explicit ImageRasterizer(sf::Image& image, const IntRect& clip_rect);
+
+    void set_pixel(i32 x, i32 y, const sf::Color& color);
+    void clear(const Color& color);
+
+    void draw_point(const Vec2f& point, const Color& color);
+    void draw_line(const Vec2f& from, const Vec2f& to, const Color& color);
+    void draw_line(const Line& line, const Color& color);
+    void draw_line_strip(std::span<const Vec2f> points, const Color& color);
+    void draw_lines(std::span<const Line> lines, const Color& color);
+    void draw_triangle(const Triangle& triangle, const Color& color);
+    void draw_rect(const Rect& rect, const Color& color);
+    void draw_circle(const Circle& circle, const Color& color);
+    void draw_ellipse(const Ellipse& ellipse, const Color& color);
+
+    void fill_span(i32 y, i32 x_start, i32 x_end, const Color& color);
+    void fill_rect(const Rect& rect, const Color& color);
+    void fill_convex_polygon(std::span<const Vec2f> points, const Color& color);
+    void fill_convex_polygon(std::span<const Line> lines, const Color& color);
+    void fill_circle(const Circle& circle, const Color& color);
+    void fill_ellipse(const Ellipse& ellipse, const Color& color);
+
+    // seed fills work on shapes of any form, one horizontal span at a time, and never leave the clip rect
+    // the stack is only used as scratch space, so reusing one across fills saves on allocations
+    void boundary_fill(const Vec2i& seed, const Color& border_color, const Color& fill_color,
+                       std::vector<Vec2i>& stack);
+    void flood_fill(const Vec2i& seed, const Color& fill_color, const Color& background_color,
+                    std::vector<Vec2i>& stack);
+
+private:
+    sf::Image& _image;
+    u8* _pixels = nullptr; // null if the image is empty
+    IntRect _clip_rect;    // always lies within the image
+
+private:
+    template<typename GetPointFn>
+    void fill_convex_polygon(usize point_count, GetPointFn&& get_point, const Color& color);
+
+    // fills the 4-connected area around the seed made up of pixels for which the predicate holds
+    // the predicate must not hold for pixels of the fill color
+    template<typename IsFillableFn>
+    void seed_fill(const Vec2i& seed, IsFillableFn&& is_fillable, const Color& fill_color,
+                   std::vector<Vec2i>& stack);
+
+    const u8* get_pixel(i32 x, i32 y) const;
+};
+
+} // namespace zth
+
+#include "Rasterizer.inl"
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdlib>
+
+namespace zth {
+
+template<typename PlotFn> void bresenham_line(const PixelLine& line, PlotFn&& plot)
+{
+    auto [x, y] = line.from;
+    auto [end_x, end_y] = line.to;
+
+    const i32 delta_x = std::abs(end_x - x);
+    const i32 delta_y = -std::abs(end_y - y);
+    const i32 step_x = x < end_x ? 1 : -1;
+    const i32 step_y = y < end_y ? 1 : -1;
+    i32 error = delta_x + delta_y;
+
+    while (true)
+    {
+        plot(x, y);
+
+        if (x == end_x && y == end_y)
+            break;
+
+        const i32 doubled_error = 2 * error;
+
+        if (doubled_error >= delta_y)
+        {
+            error += delta_y;
+            x += step_x;
+        }
+
+        if (doubled_error <= delta_x)
+        {
+            error += delta_x;
+            y += step_y;
+        }
+    }
+}
+
+template<typename PlotFn> void midpoint_circle(const Vec2i& center, i32 radius, PlotFn&& plot)
+{
+    auto [xc, yc] = center;
+    i32 x = radius;
+    i32 y = 0;
+    i32 decision = 1 - radius;
+
+    while (x >= y)
+    {
+        plot(xc + x, yc + y);
+        plot(xc + x, yc - y);
+        plot(xc - x, yc + y);
+        plot(xc - x, yc - y);
+        plot(xc + y, yc + x);
+        plot(xc + y, yc - x);
+        plot(xc - y, yc + x);
+        plot(xc - y, yc - x);
+
+        y++;
+
+        if (decision < 0)
+        {
+            decision += 2 * y + 1;
+        }
+        else
+        {
+            x--;
+            decision += 2 * (y - x) + 1;
+        }
+    }
+}
+
+template<typename PlotFn> void midpoint_ellipse(const Vec2i& center, const Vec2i& radius, PlotFn&& plot)
+{
+    auto [xc, yc] = center;
+
+    auto plot_quadrants = [&](i64 x, i64 y) {
+        auto px = static_cast<i32>(x);
+        auto py = static_cast<i32>(y);
+
+        plot(xc + px, yc + py);
+        plot(xc + px, yc - py);
+        plot(xc - px, yc + py);
+        plot(xc - px, yc - py);
+    };
+
+    // the decision variables are scaled by 4 to keep them integral, i64 keeps them from overflowing for big radii
+    const i64 rx2 = static_cast<i64>(radius.x) * radius.x;
+    const i64 ry2 = static_cast<i64>(radius.y) * radius.y;
+
+    i64 x = 0;
+    i64 y = radius.y;
+    i64 dx = 0;
+    i64 dy = 2 * rx2 * y;
+
+    // region where the slope is less than 1, stepping x every iteration
+    i64 decision = 4 * ry2 - 4 * rx2 * radius.y + rx2;
+
+    while (dx < dy)
+    {
+        plot_quadrants(x, y);
+
+        x++;
+        dx += 2 * ry2;
+
+        if (decision < 0)
+        {
+            decision += 4 * (dx + ry2);
+        }
+        else
+        {
+            y--;
+            dy -= 2 * rx2;
+            decision += 4 * (dx - dy + ry2);
+        }
+    }
+
+    // region where the slope is greater than 1, stepping y every iteration
+    decision = ry2 * (2 * x + 1) * (2 * x + 1) + 4 * rx2 * (y - 1) * (y - 1) - 4 * rx2 * ry2;
+
+    while (y >= 0)
+    {
+        plot_quadrants(x, y);
+
+        y--;
+        dy -= 2 * rx2;
+
+        if (decision > 0)
+        {
+            decision += 4 * (rx2 - dy);
+        }
+        else
+        {
+            x++;
+            dx += 2 * ry2;
+            decision += 4 * (dx - dy + rx2);
+        }
+    }
+}
+
+} // namespace zth
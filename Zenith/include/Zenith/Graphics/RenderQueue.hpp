@@ -0,0 +1,69 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+class Drawable;
+class Renderer;
+
+// what a drawable gets sorted by, in order of importance
+// the shader and the texture only count on layers which group drawables by them, where they're only compared for
+// equality, so that drawables sharing them end up next to each other
+struct RenderKey
+{
+    u16 layer;
+    const void* shader;
+    const void* texture;
+    u16 depth;
+};
+
+struct RenderCommand
+{
+    u64 sort_key;
+    const Drawable* drawable;
+};
+
+// collects the drawables of a frame and draws them sorted by their keys
+// drawables with equal keys are drawn in the order they were submitted
+// grouping a layer saves state changes, but it overrides the submission order of drawables with different shaders or
+// textures within the layer, e.g. drawables without a texture end up below every sprite, so it has to be turned on
+class RenderQueue
+{
+public:
+    explicit RenderQueue() = default;
+    ZTH_NO_COPY(RenderQueue)
+    ZTH_DEFAULT_MOVE(RenderQueue)
+
+    ~RenderQueue() = default;
+
+    void submit(const Drawable& drawable, const RenderKey& key);
+    // draws every submitted drawable and empties the queue
+    void execute(Renderer& renderer);
+    void clear();
+
+    // the drawables on a grouped layer are sorted by their shaders and textures before their depths
+    void set_layer_grouped(u16 layer, bool is_grouped = true);
+    bool is_layer_grouped(u16 layer) const;
+
+    usize size() const { return _commands.size(); }
+
+private:
+    std::vector<RenderCommand> _commands;
+    std::vector<RenderCommand> _sorted_commands;
+    std::vector<u16> _grouped_layers;
+
+    // shaders and textures get ids in the order they're first submitted in, starting from 1, 0 stands for none
+    std::unordered_map<const void*, u16> _shader_ids;
+    std::unordered_map<const void*, u16> _texture_ids;
+
+private:
+    u64 make_sort_key(const RenderKey& key);
+    void sort();
+};
+
+} // namespace zth
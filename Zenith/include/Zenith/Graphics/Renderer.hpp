@@ -3,42 +3,94 @@
 #include <SFML/Graphics.hpp>
 
 #include "Zenith/Graphics/CustomPrimitiveRenderer.hpp"
+#include "Zenith/Graphics/InstancedRenderer.hpp"
 #include "Zenith/Graphics/PrimitiveRenderer.hpp"
 #include "Zenith/Graphics/SfmlPrimitiveRenderer.hpp"
+#include "Zenith/Graphics/SpriteBatch.hpp"
+#include "Zenith/Graphics/TiledPrimitiveRenderer.hpp"
 #include "Zenith/Utility/Utility.hpp"
 
 namespace zth {
 
 class Drawable;
+class LayerCache;
 class Sprite;
 class VertexArray;
+class VertexBuffer;
 
 enum class PrimitiveRendererType
 {
     SfmlPrimitiveRenderer,
     CustomPrimitiveRenderer,
+    TiledPrimitiveRenderer,
 };
 
 class Renderer
 {
 public:
-    explicit Renderer(sf::RenderTarget& render_target) : _render_target(render_target) {}
+    explicit Renderer(sf::RenderTarget& render_target) : _render_target(&render_target) {}
     ~Renderer() = default;
     ZTH_NO_COPY_NO_MOVE(Renderer)
 
+    // sprites, instances and primitives are batched, a batch gets drawn as soon as something of another kind is
+    // drawn, so that everything ends up in the order it was drawn in
     void draw(const Drawable& drawable);
-    void draw_sprite(const Sprite& sprite) const;
-    void draw_vertex_array(const VertexArray& vertex_array) const;
+    void draw_sprite(const Sprite& sprite);
+    void draw_vertex_array(const VertexArray& vertex_array);
+    void draw_vertex_buffer(const VertexBuffer& vertex_buffer);
+    void draw_layer_cache(const LayerCache& layer_cache);
+
+    // should be called at the end of every frame, before displaying it
+    void flush();
+
+    // the part of the world visible through the current view of the render target
+    Rect view_bounds() const;
+
+    // everything drawn so far gets flushed into the current render target first
+    void set_render_target(sf::RenderTarget& render_target);
+    auto& render_target() { return *_render_target; }
+
+    auto& sprite_batch() { return _sprite_batch; }
+    // getting the instanced renderer starts a batch of instances, the same as getting the primitive renderer
+    auto& instanced_renderer()
+    {
+        begin_batch(BatchType::Instances);
+        return _instanced_renderer;
+    }
+
+    // getting the primitive renderer starts a batch of primitives, which get drawn on top of everything drawn before
+    auto& primitive_renderer()
+    {
+        begin_batch(BatchType::Primitives);
+        return _selected_primitive_renderer;
+    }
 
-    auto& primitive_renderer() { return _selected_primitive_renderer; }
     void set_primitive_renderer_type(PrimitiveRendererType primitive_renderer_type);
     PrimitiveRendererType get_primitive_renderer_type() const;
 
 private:
-    sf::RenderTarget& _render_target;
-    SfmlPrimitiveRenderer _sfml_primitive_renderer{ _render_target };
-    CustomPrimitiveRenderer _custom_primitive_renderer{ _render_target };
+    enum class BatchType : u8
+    {
+        None,
+        Sprites,
+        Instances,
+        Primitives,
+    };
+
+    sf::RenderTarget* _render_target;
+    SpriteBatch _sprite_batch;
+    InstancedRenderer _instanced_renderer{ *_render_target };
+    SfmlPrimitiveRenderer _sfml_primitive_renderer{ *_render_target };
+    CustomPrimitiveRenderer _custom_primitive_renderer{ *_render_target };
+    TiledPrimitiveRenderer _tiled_primitive_renderer{ *_render_target };
     PrimitiveRenderer* _selected_primitive_renderer = &_sfml_primitive_renderer;
+    BatchType _batch_type = BatchType::None; // the kind of the batch which is currently being gathered
+
+private:
+    // flushes the current batch if it's of another type
+    void begin_batch(BatchType batch_type);
+    // draws everything batched so far, so that whatever gets drawn next ends up on top of it
+    void flush_batches();
 };
 
 } // namespace zth
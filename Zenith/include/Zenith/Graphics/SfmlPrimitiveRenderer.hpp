@@ -4,6 +4,7 @@
 
 #include "Zenith/Graphics/Color.hpp"
 #include "Zenith/Graphics/PrimitiveRenderer.hpp"
+#include "Zenith/Graphics/UnitCircleCache.hpp"
 #include "Zenith/Graphics/VertexArray.hpp"
 #include "Zenith/Math/Geometry.hpp"
 #include "Zenith/Math/Vec2.hpp"
@@ -13,6 +14,13 @@ namespace zth {
 
 class SfmlPrimitiveRenderer : public PrimitiveRenderer
 {
+public:
+    // consecutive primitives get merged into lists of points, lines or triangles, which are only submitted once the
+    // type of the list changes or on flush
+    bool batch_draw_calls = true;
+    // how far (in pixels) the edges of circles and ellipses may stray from the real shape
+    float circle_tolerance = UnitCircleCache::default_tolerance;
+
 public:
     explicit SfmlPrimitiveRenderer(sf::RenderTarget& render_target) : PrimitiveRenderer(render_target) {}
     ~SfmlPrimitiveRenderer() override = default;
@@ -20,6 +28,9 @@ public:
 
 private:
     VertexArray _vertex_array;
+    VertexArray _batch_vertex_array;
+    PrimitiveType _batch_primitive_type = PrimitiveType::Points;
+    UnitCircleCache _unit_circle_cache;
 
 private:
     void draw_point_impl(const Vec2f& point, const Color& color) override;
@@ -67,7 +78,17 @@ private:
     void plot_filled_convex_polygon(std::span<const Vec2f> points, const Color& color);
     void plot_filled_convex_polygon(std::span<const Line> lines, const Color& color);
 
+    void plot_ellipse(const Ellipse& ellipse, const Color& color);
+    void plot_filled_ellipse(const Ellipse& ellipse, const Color& color);
+
+    void flush_impl() override;
+
     void draw_call(PrimitiveType primitive_type);
+    void add_to_batch(PrimitiveType primitive_type);
+    void submit_batch();
+
+    // strips and fans can't be merged with one another, so they get turned into lists
+    static PrimitiveType to_list_primitive_type(PrimitiveType primitive_type);
 };
 
 } // namespace zth
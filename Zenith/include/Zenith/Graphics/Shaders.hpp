@@ -6,4 +6,9 @@ namespace zth::shaders {
 
 extern const Shader basic_shader;
 
+// used by the instanced renderer, which binds its own attribute locations and relinks them before the first draw
+extern Shader instanced_rect_shader;
+extern Shader instanced_circle_shader;
+extern Shader instanced_sprite_shader;
+
 } // namespace zth::shaders
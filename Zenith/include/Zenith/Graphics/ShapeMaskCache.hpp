@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <list>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Math/Vec2.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+struct ShapeMaskSpan
+{
+    i32 y;
+    i32 x_start;
+    i32 x_end; // inclusive, the same as in ImageRasterizer::fill_span
+};
+
+// the pixels covered by a rasterized shape, stored as horizontal spans relative to the shape's top-left pixel
+struct ShapeMask
+{
+    Vec2i size;
+    std::vector<ShapeMaskSpan> spans;
+};
+
+// every pixel which isn't fully transparent counts as covered
+ShapeMask create_shape_mask(const sf::Image& image);
+
+// least recently used cache of shape masks, keyed by the parameters of a shape relative to its top-left pixel
+// a shape drawn again after being moved by whole pixels maps to the same key, so it only gets rasterized once
+// shapes moved by fractions of a pixel map to new keys, so the cache is off by default and only pays off for shapes
+// which get redrawn at the same sub-pixel offsets, e.g. ones snapped to whole pixels
+class ShapeMaskCache
+{
+public:
+    static constexpr usize default_memory_budget = 0;
+    // how many keys which missed only once are remembered before they start getting forgotten
+    static constexpr usize max_missed_key_count = 1024;
+
+public:
+    explicit ShapeMaskCache(usize memory_budget = default_memory_budget) : _memory_budget(memory_budget) {}
+    ZTH_NO_COPY_NO_MOVE(ShapeMaskCache)
+
+    ~ShapeMaskCache() = default;
+
+    // the kind tells apart keys which would otherwise be the same, e.g. keys of different types of shapes
+    const ShapeMask* find(u32 kind, std::span<const float> key);
+    // a mask only gets cached once its key misses for the second time, so that shapes which are never drawn the same
+    // way again don't evict the ones which are, masks which don't fit within the memory budget don't get cached either
+    void insert(u32 kind, std::span<const float> key, const ShapeMask& mask);
+    void clear();
+
+    // a budget of 0 turns the cache off, which is the default
+    void set_memory_budget(usize memory_budget);
+
+    usize memory_budget() const { return _memory_budget; }
+    usize memory_usage() const { return _memory_usage; }
+    usize mask_count() const { return _entries.size(); }
+
+    u64 hits() const { return _hits; }
+    u64 misses() const { return _misses; }
+    void reset_counters();
+
+private:
+    struct Entry
+    {
+        u64 hash;
+        u32 kind;
+        std::vector<float> key;
+        ShapeMask mask;
+        usize memory_usage;
+    };
+
+    std::list<Entry> _entries; // the most recently used entries come first
+    std::unordered_multimap<u64, std::list<Entry>::iterator> _lookup;
+    std::unordered_set<u64> _missed_keys; // hashes of the keys which missed once and haven't been cached yet
+
+    usize _memory_budget;
+    usize _memory_usage = 0;
+
+    u64 _hits = 0;
+    u64 _misses = 0;
+
+private:
+    static u64 hash_key(u32 kind, std::span<const float> key);
+
+    // drops the least recently used entries until the memory usage fits within the budget
+    void evict(usize memory_budget);
+};
+
+} // namespace zth
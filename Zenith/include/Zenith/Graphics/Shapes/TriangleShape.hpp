@@ -23,6 +23,7 @@ public:
     ~TriangleShape() override = default;
 
     void draw(Renderer& renderer) const override;
+    Rect bounds() const override { return triangle.bounds(); }
 
     Transformable2D& translate(const Vec2f& translation) override;
     Transformable2D& rotate(float angle) override;
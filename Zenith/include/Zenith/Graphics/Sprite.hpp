@@ -45,15 +45,17 @@ public:
     Transformable2D& scale(float factor, const Vec2f& scaling_point) override;
 
     void draw(Renderer& renderer) const override;
+    void submit(RenderQueue& render_queue) const override;
 
     void set_position(const Vec2f& pos) { _sprite.setPosition(static_cast<sf::Vector2f>(pos)); }
     auto get_position() const { return static_cast<Vec2f>(_sprite.getPosition()); }
 
-    auto bounds() const { return Rect::from_sf_rect(_sprite.getGlobalBounds()); }
+    Rect bounds() const override { return Rect::from_sf_rect(_sprite.getGlobalBounds()); }
 
     void set_texture_rect(const IntRect& texture_rect);
 
     friend class Renderer;
+    friend class InstancedRenderer;
 
 private:
     sf::Sprite _sprite;
@@ -64,6 +66,9 @@ class AnimatedSprite : public Sprite, public Animatable
 public:
     explicit AnimatedSprite(const Texture& texture, const SpriteSize& sprite_size, u32 frames,
                             float frame_length_seconds);
+    // for sprite sheets taking up only a part of the texture, e.g. packed into a TextureAtlas
+    explicit AnimatedSprite(const Texture& texture, const IntRect& sprite_sheet_rect, const SpriteSize& sprite_size,
+                            u32 frames, float frame_length_seconds);
 
     ZTH_DEFAULT_COPY_DEFAULT_MOVE(AnimatedSprite)
 
@@ -75,6 +80,7 @@ private:
     u32 _current_frame = 0;
     u32 _frames;
     SpriteSize _sprite_size;
+    Vec2i _sprite_sheet_position;
     u32 _sprite_sheet_cols;
     u32 _sprite_sheet_rows;
 
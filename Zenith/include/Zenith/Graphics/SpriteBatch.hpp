@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+enum class SpriteBatchMode
+{
+    InOrder,   // sprites are drawn in the order they were added, a new draw call starts whenever the texture changes
+    ByTexture, // sprites sharing a texture are drawn with a single draw call, in the order the textures were first used
+};
+
+// gathers the transformed quads of sprites into one vertex stream per texture
+class SpriteBatch
+{
+public:
+    SpriteBatchMode mode = SpriteBatchMode::InOrder;
+
+public:
+    explicit SpriteBatch() = default;
+    ZTH_NO_COPY(SpriteBatch)
+    ZTH_DEFAULT_MOVE(SpriteBatch)
+
+    ~SpriteBatch() = default;
+
+    void add(const sf::Sprite& sprite);
+    // draws every sprite added since the last draw and empties the batch
+    void draw(sf::RenderTarget& render_target);
+
+    usize sprite_count() const { return _sprite_count; }
+    usize draw_call_count() const { return _group_count; }
+
+private:
+    struct TextureGroup
+    {
+        const sf::Texture* texture;
+        std::vector<sf::Vertex> vertices; // triangles, 6 vertices per sprite
+    };
+
+    // groups past _group_count are kept around empty, so that their memory gets reused in the following frames
+    std::vector<TextureGroup> _groups;
+    usize _group_count = 0;
+    usize _sprite_count = 0;
+
+private:
+    TextureGroup& get_group(const sf::Texture* texture);
+};
+
+} // namespace zth
@@ -47,6 +47,7 @@ public:
 
     friend class Shader;
     friend class Sprite;
+    friend class TextureAtlas;
 
 private:
     sf::Texture _texture;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Texture.hpp"
+#include "Zenith/Math/Geometry.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+// packs several images into one texture, so that sprites using any of them can be drawn with a single texture bound
+// images are added first, then build() packs them with a skyline packer and uploads the result
+// the atlas needs to live as long as the sprites using its texture!
+class TextureAtlas
+{
+public:
+    u32 padding = 2; // space left around every image
+    // fills the padding with the edge pixels of the image instead of leaving it transparent,
+    // so that sampling right at the edge of a rect never picks up its neighbours
+    bool extrude_edges = true;
+    u32 max_size = 4096; // the largest width and height of the texture, the atlas won't build if the images don't fit
+
+public:
+    explicit TextureAtlas() = default;
+    ZTH_NO_COPY_NO_MOVE(TextureAtlas)
+
+    ~TextureAtlas() = default;
+
+    // every add function returns the index of the image, which is later used to get its rect in the texture
+    usize add_image(const sf::Image& image);
+    std::optional<usize> add_image_from_file(std::string_view path);
+    template<usize DataSize> std::optional<usize> add_image_from_memory(std::span<const u8, DataSize> data);
+    std::optional<usize> add_image_from_memory(const u8* data, usize data_size);
+
+    // packs every image added so far, can be called again after adding more images
+    // on failure every image is left without a rect and the texture is left empty
+    bool build();
+
+    const auto& texture() const { return _texture; }
+    // the rect of the image in the texture, without the padding, to be used as a sprite's texture rect
+    // empty if the image hasn't been packed, e.g. because the atlas failed to build
+    IntRect get_rect(usize image_index) const;
+
+    usize image_count() const { return _images.size(); }
+    bool is_built() const { return _rects.size() == _images.size() && !_images.empty(); }
+
+private:
+    std::vector<sf::Image> _images;
+    std::vector<IntRect> _rects;
+    Texture _texture;
+
+private:
+    void copy_image(sf::Image& atlas, const sf::Image& image, const Vec2u& position) const;
+};
+
+template<usize DataSize> std::optional<usize> TextureAtlas::add_image_from_memory(std::span<const u8, DataSize> data)
+{
+    return add_image_from_memory(data.data(), data.size_bytes());
+}
+
+} // namespace zth
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Color.hpp"
+#include "Zenith/Graphics/PrimitiveRenderer.hpp"
+#include "Zenith/Math/Geometry.hpp"
+#include "Zenith/Math/Vec2.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+// records primitives for the whole frame, bins them into screen tiles on flush and rasterizes the tiles in parallel
+// on the engine's job system into a single framebuffer
+// the output is identical to the one of the custom primitive renderer in deferred mode with scanline fills
+class TiledPrimitiveRenderer : public PrimitiveRenderer
+{
+public:
+    static constexpr i32 tile_size = 64;
+
+public:
+    explicit TiledPrimitiveRenderer(sf::RenderTarget& render_target) : PrimitiveRenderer(render_target) {}
+    ~TiledPrimitiveRenderer() override = default;
+    ZTH_NO_COPY_NO_MOVE(TiledPrimitiveRenderer)
+
+    // tiles get rasterized on the calling thread alone when there's no engine
+    usize thread_count() const;
+
+private:
+    enum class DrawCommandType
+    {
+        Point,
+        Line,
+        Ellipse,
+        FilledRect,
+        FilledConvexPolygon,
+        FilledEllipse,
+    };
+
+    struct PointRange
+    {
+        usize first; // index into _polygon_points
+        usize count;
+    };
+
+    struct DrawCommand
+    {
+        DrawCommandType type;
+        Color color;
+
+        union
+        {
+            Vec2f point;
+            Line line;
+            Ellipse ellipse;
+            Rect rect;
+            PointRange polygon;
+        };
+
+        explicit DrawCommand(DrawCommandType type, const Color& color, const Vec2f& point)
+            : type(type), color(color), point(point)
+        {}
+
+        explicit DrawCommand(DrawCommandType type, const Color& color, const Line& line)
+            : type(type), color(color), line(line)
+        {}
+
+        explicit DrawCommand(DrawCommandType type, const Color& color, const Ellipse& ellipse)
+            : type(type), color(color), ellipse(ellipse)
+        {}
+
+        explicit DrawCommand(DrawCommandType type, const Color& color, const Rect& rect)
+            : type(type), color(color), rect(rect)
+        {}
+
+        explicit DrawCommand(DrawCommandType type, const Color& color, const PointRange& polygon)
+            : type(type), color(color), polygon(polygon)
+        {}
+    };
+
+    std::vector<DrawCommand> _commands;
+    std::vector<Vec2f> _polygon_points;
+    std::vector<std::vector<u32>> _tiles; // indices of the commands touching each tile, in the order of drawing
+    Vec2i _tile_count = { 0, 0 };
+
+    sf::Image _framebuffer;
+    sf::Texture _framebuffer_texture;
+
+private:
+    void draw_point_impl(const Vec2f& point, const Color& color) override;
+    void draw_points_impl(std::span<const Vec2f> points, const Color& color) override;
+    void draw_line_impl(const Vec2f& from, const Vec2f& to, const Color& color) override;
+    void draw_line_impl(const Line& line, const Color& color) override;
+    void draw_line_strip_impl(std::span<const Vec2f> points, const Color& color) override;
+    void draw_lines_impl(std::span<const Line> lines, const Color& color) override;
+    void draw_closed_lines_impl(std::span<const Vec2f> points, const Color& color) override;
+    void draw_closed_lines_impl(std::span<const Line> lines, const Color& color) override;
+
+    void draw_triangle_impl(const Triangle& triangle, const Color& color) override;
+    void draw_filled_triangle_impl(const Triangle& triangle, const Color& color) override;
+
+    void draw_rect_impl(const Rect& rect, const Color& color) override;
+    void draw_filled_rect_impl(const Rect& rect, const Color& color) override;
+
+    void draw_convex_polygon_impl(std::span<const Vec2f> points, const Color& color) override;
+    void draw_convex_polygon_impl(std::span<const Line> lines, const Color& color) override;
+    void draw_filled_convex_polygon_impl(std::span<const Vec2f> points, const Color& color) override;
+    void draw_filled_convex_polygon_impl(std::span<const Line> lines, const Color& color) override;
+
+    void draw_circle_impl(const Circle& circle, const Color& color) override;
+    void draw_ellipse_impl(const Ellipse& ellipse, const Color& color) override;
+    void draw_filled_circle_impl(const Circle& circle, const Color& color) override;
+    void draw_filled_ellipse_impl(const Ellipse& ellipse, const Color& color) override;
+
+    void flush_impl() override;
+
+    void record_line(const Vec2f& from, const Vec2f& to, const Color& color);
+
+    void bin_commands();
+    void bin_command(u32 command_index, const IntRect& bounds);
+    std::optional<IntRect> get_command_bounds(const DrawCommand& command) const;
+
+    void rasterize_tile(usize tile_index);
+};
+
+} // namespace zth
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Math/Vec2.hpp"
+
+namespace zth {
+
+// rings of points lying on the unit circle, one for every level of detail, built the first time they're needed
+// every ring starts at the top and goes clockwise on screen, the same as SfmlEllipseShape
+// circles and ellipses are drawn by scaling and translating the points of a ring
+class UnitCircleCache
+{
+public:
+    static constexpr usize min_point_count = 8;
+    static constexpr usize level_count = 8; // the point count doubles with every level, up to 1024
+    static constexpr float default_tolerance = 0.25f; // in pixels
+
+public:
+    // the lowest level whose ring stays within the tolerance from the edge of a circle of the given radius
+    // for ellipses the larger of the radii should be used
+    static usize get_level(float radius, float tolerance = default_tolerance);
+    static usize get_point_count(usize level) { return min_point_count << level; }
+
+    std::span<const Vec2f> get_ring(usize level);
+    std::span<const Vec2f> get_ring(float radius, float tolerance = default_tolerance);
+
+private:
+    std::array<std::vector<Vec2f>, level_count> _rings;
+};
+
+} // namespace zth
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+#include <type_traits>
 
 #include "Zenith/Graphics/Color.hpp"
 #include "Zenith/Math/Vec2.hpp"
@@ -21,4 +25,18 @@ struct Vertex
     }
 };
 
+// vertices get handed to sfml without any conversion, so they have to be laid out exactly the same
+static_assert(std::is_trivially_copyable_v<Vertex>);
+static_assert(std::is_standard_layout_v<Vertex>);
+static_assert(sizeof(Vertex) == sizeof(sf::Vertex));
+static_assert(alignof(Vertex) == alignof(sf::Vertex));
+static_assert(offsetof(Vertex, position) == offsetof(sf::Vertex, position));
+static_assert(offsetof(Vertex, color) == offsetof(sf::Vertex, color));
+static_assert(offsetof(Vertex, tex_coords) == offsetof(sf::Vertex, texCoords));
+
+inline const sf::Vertex* to_sf_vertices(const Vertex* vertices)
+{
+    return reinterpret_cast<const sf::Vertex*>(vertices);
+}
+
 } // namespace zth
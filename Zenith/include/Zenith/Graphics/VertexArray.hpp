@@ -1,8 +1,10 @@
 #pragma once
 
-#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 
 #include <span>
+#include <vector>
 
 #include "Zenith/Core/Typedefs.hpp"
 #include "Zenith/Graphics/Vertex.hpp"
@@ -25,39 +27,47 @@ PrimitiveType to_primitive_type(sf::PrimitiveType primitive_type);
 sf::PrimitiveType to_sf_primitive_type(PrimitiveType primitive_type);
 const char* to_string(PrimitiveType primitive_type);
 
+// the smallest rect containing the positions of all the vertices
+Rect get_bounds(std::span<const Vertex> vertices);
+
 class VertexArray : public Drawable
 {
 public:
     explicit VertexArray() = default;
-    explicit VertexArray(PrimitiveType primitive_type) : _vertex_array(to_sf_primitive_type(primitive_type)) {}
+    explicit VertexArray(PrimitiveType primitive_type) : _primitive_type(primitive_type) {}
 
     void draw(Renderer& renderer) const override;
 
-    void set_primitive_type(PrimitiveType primitive_type)
-    {
-        _vertex_array.setPrimitiveType(to_sf_primitive_type(primitive_type));
-    }
+    void set_primitive_type(PrimitiveType primitive_type) { _primitive_type = primitive_type; }
+
+    void append(const Vertex& vertex) { _vertices.push_back(vertex); }
+    void append(std::span<const Vertex> vertices);
 
-    void append(const Vertex& vertex) { _vertex_array.append(static_cast<sf::Vertex>(vertex)); }
+    // makes room for count more vertices and returns them, so that they can be written in place
+    std::span<Vertex> append(usize count);
 
-    void append(std::span<const Vertex> vertices)
-    {
-        for (const auto& vertex : vertices)
-            append(vertex);
-    }
+    void reserve(usize vertex_count) { _vertices.reserve(vertex_count); }
+    void resize(usize vertex_count) { _vertices.resize(vertex_count); }
+    void clear() { _vertices.clear(); }
 
-    void clear() { _vertex_array.clear(); }
+    std::span<Vertex> vertices() { return _vertices; }
+    std::span<const Vertex> vertices() const { return _vertices; }
 
-    auto primitive_type() const { return to_primitive_type(_vertex_array.getPrimitiveType()); }
-    auto vertex_count() const { return _vertex_array.getVertexCount(); }
-    auto bounds() const { return Rect::from_sf_rect(_vertex_array.getBounds()); }
+    auto primitive_type() const { return _primitive_type; }
+    auto vertex_count() const { return _vertices.size(); }
+    auto capacity() const { return _vertices.capacity(); }
+    Rect bounds() const override { return get_bounds(_vertices); }
 
     friend class Renderer;
     friend class SfmlPrimitiveRenderer;
     friend class CustomPrimitiveRenderer;
 
 private:
-    sf::VertexArray _vertex_array{};
+    std::vector<Vertex> _vertices;
+    PrimitiveType _primitive_type = PrimitiveType::Points;
+
+private:
+    void draw_to(sf::RenderTarget& render_target) const;
 };
 
 } // namespace zth
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SFML/Graphics/VertexBuffer.hpp>
+
+#include <span>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Drawable.hpp"
+#include "Zenith/Graphics/Vertex.hpp"
+#include "Zenith/Graphics/VertexArray.hpp"
+#include "Zenith/Math/Geometry.hpp"
+#include "Zenith/Utility/Utility.hpp"
+
+namespace zth {
+
+// how often the vertices of a buffer are expected to change, lets the driver pick where to store them
+enum class VertexBufferUsage : u8
+{
+    Static,  // uploaded once, drawn many times
+    Dynamic, // changed every now and then
+    Stream,  // changed every frame
+};
+
+sf::VertexBuffer::Usage to_sf_vertex_buffer_usage(VertexBufferUsage usage);
+const char* to_string(VertexBufferUsage usage);
+
+// geometry stored in gpu memory, unlike VertexArray, which uploads all of its vertices on every draw
+// drawing does nothing if vertex buffers aren't supported, which can be checked with is_available()
+class VertexBuffer : public Drawable
+{
+public:
+    explicit VertexBuffer(PrimitiveType primitive_type, VertexBufferUsage usage = VertexBufferUsage::Static);
+    explicit VertexBuffer(PrimitiveType primitive_type, std::span<const Vertex> vertices,
+                          VertexBufferUsage usage = VertexBufferUsage::Static);
+    ZTH_NO_COPY_NO_MOVE(VertexBuffer)
+
+    ~VertexBuffer() override = default;
+
+    void draw(Renderer& renderer) const override;
+
+    // replaces the whole contents of the buffer
+    bool set_vertices(std::span<const Vertex> vertices);
+    // overwrites the vertices starting at offset, the buffer doesn't grow
+    bool update(std::span<const Vertex> vertices, usize offset);
+
+    void set_primitive_type(PrimitiveType primitive_type)
+    {
+        _vertex_buffer.setPrimitiveType(to_sf_primitive_type(primitive_type));
+    }
+
+    auto primitive_type() const { return to_primitive_type(_vertex_buffer.getPrimitiveType()); }
+    auto usage() const { return _usage; }
+    auto vertex_count() const { return _vertex_buffer.getVertexCount(); }
+    // the bounds only grow on partial updates, as the vertices which weren't overwritten aren't kept in memory
+    Rect bounds() const override { return _bounds; }
+
+    static bool is_available() { return sf::VertexBuffer::isAvailable(); }
+
+    friend class Renderer;
+
+private:
+    sf::VertexBuffer _vertex_buffer;
+    VertexBufferUsage _usage;
+    Rect _bounds{};
+};
+
+} // namespace zth
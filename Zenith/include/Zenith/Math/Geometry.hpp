@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics/Rect.hpp>
 
+#include <algorithm>
 #include <array>
 #include <span>
 
@@ -9,6 +10,8 @@
 
 namespace zth {
 
+struct Rect;
+
 struct Line
 {
     Vec2f from;
@@ -42,6 +45,8 @@ struct Triangle
     constexpr Triangle& scale(float factor);
     constexpr Triangle scaled(float factor, const Vec2f& scaling_point) const;
     constexpr Triangle& scale(float factor, const Vec2f& scaling_point);
+
+    constexpr Rect bounds() const;
 };
 
 struct Rect
@@ -68,6 +73,7 @@ struct Rect
     constexpr std::array<Vec2f, 4> points() const;
     constexpr Vec2f center() const;
     constexpr bool contains(const Vec2f& point) const;
+    constexpr bool intersects(const Rect& other) const;
 };
 
 struct IntRect
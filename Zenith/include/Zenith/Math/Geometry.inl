@@ -149,6 +149,14 @@ constexpr Triangle& Triangle::scale(float factor, const Vec2f& scaling_point)
     return *this = this->scaled(factor, scaling_point);
 }
 
+constexpr Rect Triangle::bounds() const
+{
+    auto [min_x, max_x] = std::minmax({ points[0].x, points[1].x, points[2].x });
+    auto [min_y, max_y] = std::minmax({ points[0].y, points[1].y, points[2].y });
+
+    return { { min_x, min_y }, { max_x - min_x, max_y - min_y } };
+}
+
 inline Rect Rect::from_sf_rect(const sf::FloatRect& rect)
 {
     return {
@@ -262,6 +270,17 @@ constexpr bool Rect::contains(const Vec2f& point) const
         return false;
 }
 
+constexpr bool Rect::intersects(const Rect& other) const
+{
+    // the size can be negative, in which case the position is the bottom-right corner
+    const auto [left, right] = std::minmax({ position.x, position.x + size.x });
+    const auto [top, bottom] = std::minmax({ position.y, position.y + size.y });
+    const auto [other_left, other_right] = std::minmax({ other.position.x, other.position.x + other.size.x });
+    const auto [other_top, other_bottom] = std::minmax({ other.position.y, other.position.y + other.size.y });
+
+    return left <= other_right && other_left <= right && top <= other_bottom && other_top <= bottom;
+}
+
 constexpr Vec2f Rect::center() const
 {
     return (position + (position + size)) / 2.0f;
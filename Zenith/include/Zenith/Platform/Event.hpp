@@ -5,9 +5,12 @@
 #include <array>
 #include <cassert>
 #include <optional>
+#include <utility>
 
+#include "Zenith/Core/Typedefs.hpp"
 #include "Zenith/Platform/Input/Input.hpp"
 #include "Zenith/Platform/Resolution.hpp"
+#include "Zenith/Utility/EnumFlags.hpp"
 
 namespace zth {
 
@@ -73,6 +76,60 @@ inline constexpr std::array event_type_enumerations = {
     // clang-format on
 };
 
+// a set of event types, with the bit of every event type at the position of its value
+enum class EventTypeFlags
+{
+    // keep this list consistent with the event types
+
+    None = 0,
+    WindowClosed = 1 << 0,
+    WindowResized = 1 << 1,
+    LostFocus = 1 << 2,
+    GainedFocus = 1 << 3,
+    KeyPressed = 1 << 4,
+    KeyReleased = 1 << 5,
+    MouseWheelScrolled = 1 << 6,
+    MouseButtonPressed = 1 << 7,
+    MouseButtonReleased = 1 << 8,
+    MouseMoved = 1 << 9,
+    MouseEntered = 1 << 10,
+    MouseLeft = 1 << 11,
+    All = (1 << 12) - 1,
+};
+
+ZTH_MAKE_ENUM_FLAGS(EventTypeFlags);
+
+constexpr EventTypeFlags to_event_type_flags(EventType event_type)
+{
+    return static_cast<EventTypeFlags>(1 << std::to_underlying(event_type));
+}
+
+// catch the event types, the array and the flags going out of sync
+static_assert([] {
+    for (usize i = 0; i < event_type_enumerations.size(); i++)
+    {
+        if (static_cast<usize>(std::to_underlying(event_type_enumerations[i])) != i)
+            return false;
+    }
+
+    return true;
+}());
+
+static_assert(std::to_underlying(EventTypeFlags::All) == (1 << event_type_enumerations.size()) - 1);
+
+static_assert(to_event_type_flags(EventType::WindowClosed) == EventTypeFlags::WindowClosed);
+static_assert(to_event_type_flags(EventType::WindowResized) == EventTypeFlags::WindowResized);
+static_assert(to_event_type_flags(EventType::LostFocus) == EventTypeFlags::LostFocus);
+static_assert(to_event_type_flags(EventType::GainedFocus) == EventTypeFlags::GainedFocus);
+static_assert(to_event_type_flags(EventType::KeyPressed) == EventTypeFlags::KeyPressed);
+static_assert(to_event_type_flags(EventType::KeyReleased) == EventTypeFlags::KeyReleased);
+static_assert(to_event_type_flags(EventType::MouseWheelScrolled) == EventTypeFlags::MouseWheelScrolled);
+static_assert(to_event_type_flags(EventType::MouseButtonPressed) == EventTypeFlags::MouseButtonPressed);
+static_assert(to_event_type_flags(EventType::MouseButtonReleased) == EventTypeFlags::MouseButtonReleased);
+static_assert(to_event_type_flags(EventType::MouseMoved) == EventTypeFlags::MouseMoved);
+static_assert(to_event_type_flags(EventType::MouseEntered) == EventTypeFlags::MouseEntered);
+static_assert(to_event_type_flags(EventType::MouseLeft) == EventTypeFlags::MouseLeft);
+
 class Event
 {
 public:
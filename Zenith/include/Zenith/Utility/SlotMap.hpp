@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Zenith/Core/Typedefs.hpp"
+
+namespace zth {
+
+// stores values densely, in the order they were inserted in, and hands out handles to them, which stay valid until the
+// value gets erased
+// a handle to an erased value never refers to another value, even if its slot gets reused
+// inserting and looking values up are O(1), erasing keeps the order of the remaining values, so it moves every value
+// past the first erased one, erasing many values at once only does that a single time
+template<typename T> class SlotMap
+{
+public:
+    struct Handle
+    {
+        u32 index = std::numeric_limits<u32>::max();
+        u32 generation = 0;
+
+        bool operator==(const Handle&) const = default;
+    };
+
+public:
+    Handle insert(T value)
+    {
+        u32 slot_index;
+
+        if (_free_slot != no_slot)
+        {
+            slot_index = _free_slot;
+            _free_slot = _slots[slot_index].value_index;
+        }
+        else
+        {
+            slot_index = static_cast<u32>(_slots.size());
+            _slots.push_back({ .value_index = 0, .generation = 0 });
+        }
+
+        auto& slot = _slots[slot_index];
+        slot.value_index = static_cast<u32>(_values.size());
+
+        _values.push_back(std::move(value));
+        _value_slots.push_back(slot_index);
+
+        return { .index = slot_index, .generation = slot.generation };
+    }
+
+    bool erase(Handle handle) { return erase(std::span{ &handle, 1 }) != 0; }
+
+    // handles which are invalid, or repeated, are skipped, returns how many values got erased
+    usize erase(std::span<const Handle> handles)
+    {
+        usize erased_count = 0;
+        auto first_erased_index = static_cast<u32>(_values.size());
+
+        for (const auto& handle : handles)
+        {
+            if (!contains(handle))
+                continue;
+
+            auto& slot = _slots[handle.index];
+            first_erased_index = std::min(first_erased_index, slot.value_index);
+            _value_slots[slot.value_index] = no_slot;
+
+            // bumping the generation is what invalidates the handles to the erased value
+            slot.generation++;
+            slot.value_index = _free_slot;
+            _free_slot = handle.index;
+
+            erased_count++;
+        }
+
+        if (erased_count == 0)
+            return 0;
+
+        // move the remaining values down over the erased ones, keeping their order
+        auto kept_count = first_erased_index;
+
+        for (auto value_index = first_erased_index; value_index < _values.size(); value_index++)
+        {
+            const auto slot_index = _value_slots[value_index];
+
+            if (slot_index == no_slot)
+                continue;
+
+            _values[kept_count] = std::move(_values[value_index]);
+            _value_slots[kept_count] = slot_index;
+            _slots[slot_index].value_index = kept_count;
+            kept_count++;
+        }
+
+        _values.erase(_values.begin() + kept_count, _values.end());
+        _value_slots.erase(_value_slots.begin() + kept_count, _value_slots.end());
+
+        return erased_count;
+    }
+
+    bool contains(Handle handle) const
+    {
+        return handle.index < _slots.size() && _slots[handle.index].generation == handle.generation;
+    }
+
+    T* get(Handle handle)
+    {
+        if (!contains(handle))
+            return nullptr;
+
+        return &_values[_slots[handle.index].value_index];
+    }
+
+    const T* get(Handle handle) const
+    {
+        if (!contains(handle))
+            return nullptr;
+
+        return &_values[_slots[handle.index].value_index];
+    }
+
+    void clear()
+    {
+        for (auto slot_index : _value_slots)
+        {
+            auto& slot = _slots[slot_index];
+            slot.generation++;
+            slot.value_index = _free_slot;
+            _free_slot = slot_index;
+        }
+
+        _values.clear();
+        _value_slots.clear();
+    }
+
+    // the values in the order they were inserted in
+    std::span<T> values() { return _values; }
+    std::span<const T> values() const { return _values; }
+
+    auto size() const { return _values.size(); }
+    auto empty() const { return _values.empty(); }
+
+private:
+    static constexpr u32 no_slot = std::numeric_limits<u32>::max();
+
+    struct Slot
+    {
+        u32 value_index; // the index of the next free slot if the slot is free
+        u32 generation;
+    };
+
+    std::vector<T> _values;
+    std::vector<u32> _value_slots; // the index of the slot of every value
+    std::vector<Slot> _slots;
+    u32 _free_slot = no_slot;
+};
+
+} // namespace zth
@@ -2,6 +2,7 @@
 
 #include "EnumFlags.hpp"
 #include "GlobalAccessPtr.hpp"
+#include "SlotMap.hpp"
 
 #define ZTH_NO_COPY(type)                                                                                              \
     type(const type&) = delete;                                                                                        \
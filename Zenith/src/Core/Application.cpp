@@ -29,21 +29,26 @@ void Application::run()
         engine->_delta_time = delta_t_clock.restart().asMilliseconds() / 1000.0;
         engine->window.clear();
 
+        // all the events get polled first, so that bursts of them like mouse moves get coalesced
+        engine->_event_queue.clear();
+
         while (auto event = engine->window.poll_event())
-        {
-            const auto& ev = event.value();
+            engine->_event_queue.push(event.value());
 
-            if (ev.type() == EventType::WindowClosed)
+        for (const auto& event : engine->_event_queue.events())
+        {
+            if (event.type() == EventType::WindowClosed)
             {
-                handle_event(ev);
+                handle_event(event);
                 engine->window.close();
                 return;
             }
 
-            handle_event(ev);
+            handle_event(event);
         }
 
         handle_update();
+        engine->window.renderer.flush();
         engine->window.display();
         engine->_frame_counter.update();
     }
@@ -4,41 +4,76 @@
 
 namespace zth {
 
-void EventDispatcher::register_listener(EventListener& listener)
+void EventDispatcher::register_listener(EventListener& listener, EventTypeFlags event_types)
 {
     for (const auto& event_type : event_type_enumerations)
-        register_listener(event_type, listener);
+    {
+        if (has_flag(event_types, to_event_type_flags(event_type)))
+            get_listeners(event_type).push_back(&listener);
+    }
 }
 
 void EventDispatcher::register_listener(EventType event_type, EventListener& listener)
 {
-    auto& listeners = _listeners_map[event_type];
-    listeners.push_back(&listener);
+    register_listener(listener, to_event_type_flags(event_type));
 }
 
 void EventDispatcher::deregister_listener(EventType event_type, const EventListener& listener)
 {
-    auto& listeners = _listeners_map[event_type];
-    std::erase(listeners, &listener);
+    deregister_listener(listener, to_event_type_flags(event_type));
 }
 
-void EventDispatcher::deregister_listener(const EventListener& listener)
+void EventDispatcher::deregister_listener(const EventListener& listener, EventTypeFlags event_types)
 {
-    for (auto& listeners : _listeners_map | std::views::values)
-        std::erase(listeners, &listener);
+    for (const auto& event_type : event_type_enumerations)
+    {
+        if (!has_flag(event_types, to_event_type_flags(event_type)))
+            continue;
+
+        auto& listeners = get_listeners(event_type);
+
+        if (_dispatch_depth == 0)
+        {
+            std::erase(listeners, &listener);
+        }
+        else
+        {
+            std::ranges::replace(listeners, &listener, nullptr);
+            _has_deregistered_listeners = true;
+        }
+    }
 }
 
 void EventDispatcher::dispatch(const Event& event)
 {
-    // TODO:
-    // modifying listeners map during iterating over listeners will invalidate the iterators
-    // we should probably collect all the event listeners into a vector before iterating over
-    // them and calling on_event
+    auto& listeners = get_listeners(event.type());
+
+    // listeners registered meanwhile get appended past the ones which were there when the dispatch started,
+    // the vector can grow, so the listeners are accessed by index
+    const auto listener_count = listeners.size();
+
+    _dispatch_depth++;
 
-    const auto& listeners = _listeners_map[event.type()];
+    for (usize i = 0; i < listener_count; i++)
+    {
+        if (auto listener = listeners[i])
+            listener->on_event(event);
+    }
 
-    for (const auto& listener : listeners)
-        listener->on_event(event);
+    _dispatch_depth--;
+
+    if (_dispatch_depth == 0 && _has_deregistered_listeners)
+    {
+        for (auto& event_type_listeners : _listeners)
+            std::erase(event_type_listeners, nullptr);
+
+        _has_deregistered_listeners = false;
+    }
+}
+
+std::vector<EventListener*>& EventDispatcher::get_listeners(EventType event_type)
+{
+    return _listeners[static_cast<usize>(event_type)];
 }
 
 } // namespace zth
@@ -0,0 +1,29 @@
+#include "Zenith/Core/EventQueue.hpp"
+
+namespace zth {
+
+static bool is_coalescable(EventType event_type)
+{
+    return event_type == EventType::MouseMoved || event_type == EventType::WindowResized;
+}
+
+void EventQueue::push(const Event& event)
+{
+    // only consecutive events get collapsed, so that every other event still sees the state it happened in
+    if (is_coalescable(event.type()) && !_events.empty() && _events.back().type() == event.type())
+    {
+        _events.back() = event;
+        _coalesced_count++;
+        return;
+    }
+
+    _events.push_back(event);
+}
+
+void EventQueue::clear()
+{
+    _events.clear();
+    _coalesced_count = 0;
+}
+
+} // namespace zth
@@ -0,0 +1,220 @@
+#include "Zenith/Core/JobSystem.hpp"
+
+namespace zth {
+
+// the job system the current thread belongs to and the index of its queue
+static thread_local const JobSystem* current_job_system = nullptr;
+static thread_local usize current_queue_index = 0;
+
+bool WorkStealingQueue::push(Job* job)
+{
+    const auto bottom = _bottom.load(std::memory_order_relaxed);
+    const auto top = _top.load(std::memory_order_acquire);
+
+    if (bottom - top >= static_cast<i64>(capacity))
+        return false;
+
+    _jobs[static_cast<usize>(bottom) & (capacity - 1)].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+Job* WorkStealingQueue::pop()
+{
+    const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto job = _jobs[static_cast<usize>(bottom) & (capacity - 1)].load(std::memory_order_relaxed);
+
+    // the last job can get stolen at the same time, whoever moves the top first gets it
+    if (top == bottom)
+    {
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+Job* WorkStealingQueue::steal()
+{
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return nullptr;
+
+    auto job = _jobs[static_cast<usize>(top) & (capacity - 1)].load(std::memory_order_relaxed);
+
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+
+    return job;
+}
+
+JobSystem::JobSystem(usize thread_count)
+{
+    thread_count = std::max(thread_count, usize{ 1 });
+
+    _queues.reserve(thread_count);
+
+    for (usize i = 0; i < thread_count; i++)
+        _queues.push_back(std::make_unique<WorkStealingQueue>());
+
+    current_job_system = this;
+    current_queue_index = 0;
+
+    _workers.reserve(thread_count - 1);
+
+    for (usize i = 1; i < thread_count; i++)
+        _workers.emplace_back([this, i](std::stop_token stop_token) { worker_loop(stop_token, i); });
+}
+
+JobSystem::~JobSystem()
+{
+    if (current_job_system == this)
+        current_job_system = nullptr;
+}
+
+void JobSystem::run(std::function<void()> function, JobCounter& counter)
+{
+    counter._count.fetch_add(1, std::memory_order_relaxed);
+    push(new Job{ .function = std::move(function), .counter = &counter });
+}
+
+void JobSystem::run_after(JobCounter& dependency, std::function<void()> function, JobCounter& counter)
+{
+    counter._count.fetch_add(1, std::memory_order_relaxed);
+    auto job = new Job{ .function = std::move(function), .counter = &counter };
+
+    {
+        // the dependency can't finish while it's locked, so the job either gets queued here or by the dependency
+        std::scoped_lock lock{ dependency._mutex };
+
+        if (!dependency.is_done())
+        {
+            dependency._continuations.push_back(job);
+            return;
+        }
+    }
+
+    push(job);
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    while (!counter.is_done())
+    {
+        if (auto job = find_job())
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+
+    // the thread which finished the last job might still be holding the lock
+    std::scoped_lock lock{ counter._mutex };
+}
+
+void JobSystem::push(Job* job)
+{
+    assert(current_job_system == this);
+
+    _queued_job_count.fetch_add(1);
+
+    // a full queue means there's plenty of work already, so the job might as well run right away
+    if (!_queues[current_queue_index]->push(job))
+    {
+        _queued_job_count.fetch_sub(1);
+        execute(job);
+        return;
+    }
+
+    if (_sleeping_worker_count.load() > 0)
+    {
+        // a worker about to sleep holds the lock until it's waiting, so that the notification doesn't get lost
+        {
+            std::scoped_lock lock{ _mutex };
+        }
+
+        _job_queued.notify_one();
+    }
+}
+
+Job* JobSystem::find_job()
+{
+    assert(current_job_system == this);
+
+    auto job = _queues[current_queue_index]->pop();
+
+    // the other queues are tried starting from the next one, so that the thieves spread out
+    for (usize i = 1; !job && i < _queues.size(); i++)
+        job = _queues[(current_queue_index + i) % _queues.size()]->steal();
+
+    if (job)
+        _queued_job_count.fetch_sub(1);
+
+    return job;
+}
+
+void JobSystem::execute(Job* job)
+{
+    job->function();
+
+    auto& counter = *job->counter;
+    delete job;
+
+    finish(counter);
+}
+
+void JobSystem::finish(JobCounter& counter)
+{
+    std::vector<Job*> continuations;
+
+    {
+        std::scoped_lock lock{ counter._mutex };
+
+        if (counter._count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        continuations.swap(counter._continuations);
+    }
+
+    for (auto job : continuations)
+        push(job);
+}
+
+void JobSystem::worker_loop(std::stop_token stop_token, usize queue_index)
+{
+    current_job_system = this;
+    current_queue_index = queue_index;
+
+    while (!stop_token.stop_requested())
+    {
+        if (auto job = find_job())
+        {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock lock{ _mutex };
+
+        _sleeping_worker_count++;
+        _job_queued.wait(lock, stop_token, [&] { return _queued_job_count.load() > 0; });
+        _sleeping_worker_count--;
+    }
+}
+
+} // namespace zth
@@ -2,22 +2,23 @@
 
 #include "Zenith/Core/Engine.hpp"
 #include "Zenith/Graphics/Animatable.hpp"
+#include "Zenith/Graphics/Drawable.hpp"
 
 namespace zth {
 
-void Scene::register_updatable(Updatable& updatable)
+UpdatableHandle Scene::register_updatable(Updatable& updatable, UpdatePhase update_phase)
 {
-    _updater.register_updatable(updatable);
+    return _updater.register_updatable(updatable, update_phase);
 }
 
-void Scene::deregister_updatable(const Updatable& updatable)
+void Scene::deregister_updatable(const UpdatableHandle& handle)
 {
-    _updater.deregister_updatable(updatable);
+    _updater.deregister_updatable(handle);
 }
 
-void Scene::register_event_listener(EventListener& listener)
+void Scene::register_event_listener(EventListener& listener, EventTypeFlags event_types)
 {
-    _event_dispatcher.register_listener(listener);
+    _event_dispatcher.register_listener(listener, event_types);
 }
 
 void Scene::register_event_listener(EventType event_type, EventListener& listener)
@@ -30,41 +31,124 @@ void Scene::deregister_event_listener(EventType event_type, const EventListener&
     _event_dispatcher.deregister_listener(event_type, listener);
 }
 
-void Scene::deregister_event_listener(const EventListener& listener)
+void Scene::deregister_event_listener(const EventListener& listener, EventTypeFlags event_types)
 {
-    _event_dispatcher.deregister_listener(listener);
+    _event_dispatcher.deregister_listener(listener, event_types);
 }
 
-void Scene::register_drawable(Drawable& drawable)
+DrawableHandle Scene::register_drawable(Drawable& drawable)
 {
-    _drawables.push_back(&drawable);
+    invalidate_layer(drawable.layer);
+    return _drawables.add(drawable);
 }
 
-void Scene::deregister_drawable(Drawable& drawable)
+void Scene::deregister_drawable(DrawableHandle handle)
 {
-    std::erase(_drawables, &drawable);
+    if (auto drawable = _drawables.get(handle))
+        invalidate_layer(drawable->layer);
+
+    _drawables.remove(handle);
 }
 
-void Scene::register_animatable(Animatable& animatable)
+AnimatableHandle Scene::register_animatable(Animatable& animatable)
 {
-    _animatables.push_back(&animatable);
+    return _animatables.add(animatable);
 }
 
-void Scene::deregister_animatable(Animatable& animatable)
+void Scene::deregister_animatable(AnimatableHandle handle)
 {
-    std::erase(_animatables, &animatable);
+    _animatables.remove(handle);
 }
 
-void Scene::update()
+void Scene::set_layer_static(u16 layer, bool is_static)
 {
-    on_update();
-    _updater.update();
+    if (is_static == is_layer_static(layer))
+        return;
+
+    if (is_static)
+    {
+        auto& layer_cache = _layer_caches.emplace_back(std::make_unique<LayerCache>(layer));
+        layer_cache->set_grouped(is_layer_grouped(layer));
+    }
+    else
+        std::erase_if(_layer_caches, [&](const auto& layer_cache) { return layer_cache->layer == layer; });
+}
 
-    for (auto& animatable : _animatables)
-        animatable->animate();
+bool Scene::is_layer_static(u16 layer) const
+{
+    return find_layer_cache(layer) != nullptr;
+}
 
-    for (auto& drawable : _drawables)
-        engine->window.renderer.draw(*drawable);
+void Scene::invalidate_layer(u16 layer)
+{
+    if (auto layer_cache = find_layer_cache(layer))
+        layer_cache->invalidate();
+}
+
+void Scene::set_layer_grouped(u16 layer, bool is_grouped)
+{
+    _render_queue.set_layer_grouped(layer, is_grouped);
+
+    if (auto layer_cache = find_layer_cache(layer))
+        layer_cache->set_grouped(is_grouped);
+}
+
+bool Scene::is_layer_grouped(u16 layer) const
+{
+    return _render_queue.is_layer_grouped(layer);
+}
+
+void Scene::update()
+{
+    on_update();
+    _updater.update(engine->job_system);
+
+    _animatables.for_each([](Animatable& animatable) { animatable.animate(); });
+
+    auto& renderer = engine->window.renderer;
+    const auto view_bounds = renderer.view_bounds();
+
+    for (auto& layer_cache : _layer_caches)
+    {
+        if (!layer_cache->is_up_to_date(renderer.render_target()))
+            layer_cache->redraw(renderer, _drawables.objects(), cull_drawables);
+
+        // the layer gets drawn directly if its cache couldn't be drawn
+        if (layer_cache->is_valid())
+            layer_cache->submit(_render_queue);
+    }
+
+    // some drawables compute their bounds from all of their vertices, so they're tested in parallel
+    constexpr usize min_visibility_batch_size = 64;
+
+    const auto drawables = _drawables.objects();
+    _drawable_visibilities.resize(drawables.size());
+
+    engine->job_system.parallel_for(
+        drawables.size(),
+        [&](usize index) { _drawable_visibilities[index] = get_visibility(*drawables[index], view_bounds); },
+        min_visibility_batch_size);
+
+    _culling_stats = { .drawn_count = 0, .culled_count = 0, .cached_count = 0 };
+
+    for (usize i = 0; i < drawables.size(); i++)
+    {
+        switch (_drawable_visibilities[i])
+        {
+        case DrawableVisibility::Visible:
+            drawables[i]->submit(_render_queue);
+            _culling_stats.drawn_count++;
+            break;
+        case DrawableVisibility::Culled:
+            _culling_stats.culled_count++;
+            break;
+        case DrawableVisibility::Cached:
+            _culling_stats.cached_count++;
+            break;
+        }
+    }
+
+    _render_queue.execute(renderer);
 }
 
 void Scene::dispatch_event(const Event& event)
@@ -73,4 +157,25 @@ void Scene::dispatch_event(const Event& event)
     _event_dispatcher.dispatch(event);
 }
 
+Scene::DrawableVisibility Scene::get_visibility(const Drawable& drawable, const Rect& view_bounds) const
+{
+    if (auto layer_cache = find_layer_cache(drawable.layer); layer_cache && layer_cache->is_valid())
+        return DrawableVisibility::Cached;
+
+    if (cull_drawables && !drawable.bounds().intersects(view_bounds))
+        return DrawableVisibility::Culled;
+
+    return DrawableVisibility::Visible;
+}
+
+LayerCache* Scene::find_layer_cache(u16 layer) const
+{
+    auto it = std::ranges::find_if(_layer_caches, [&](const auto& layer_cache) { return layer_cache->layer == layer; });
+
+    if (it == _layer_caches.end())
+        return nullptr;
+
+    return it->get();
+}
+
 } // namespace zth
@@ -1,28 +1,59 @@
 #include "Zenith/Core/Updater.hpp"
 
+#include "Zenith/Core/JobSystem.hpp"
 #include "Zenith/Core/Updatable.hpp"
 
 namespace zth {
 
-void Updater::register_updatable(Updatable& updatable)
+const char* to_string(UpdatePhase update_phase)
 {
-    _updatables.push_back(&updatable);
+    switch (update_phase)
+    {
+        using enum UpdatePhase;
+    case Parallel:
+        return "Parallel";
+    case Serial:
+        return "Serial";
+    }
+
+    assert(false);
+    return "Unknown";
 }
 
-void Updater::deregister_updatable(const Updatable& updatable)
+UpdatableHandle Updater::register_updatable(Updatable& updatable, UpdatePhase update_phase)
 {
-    std::erase(_updatables, &updatable);
+    return { .handle = get_registry(update_phase).add(updatable), .update_phase = update_phase };
+}
+
+void Updater::deregister_updatable(const UpdatableHandle& handle)
+{
+    get_registry(handle.update_phase).remove(handle.handle);
+}
+
+void Updater::update(JobSystem& job_system)
+{
+    // updates which do next to nothing aren't worth a job on their own
+    constexpr usize min_parallel_batch_size = 16;
+
+    // returns once every parallel updatable is done, which is the barrier before the serial phase
+    _parallel_updatables.parallel_for_each(
+        job_system, [](Updatable& updatable) { updatable.on_update(); }, min_parallel_batch_size);
+
+    _serial_updatables.for_each([](Updatable& updatable) { updatable.on_update(); });
 }
 
-void Updater::update() const
+Registry<Updatable>& Updater::get_registry(UpdatePhase update_phase)
 {
-    // TODO:
-    // modifying updatables vector during iterating over updatables will invalidate the iterators
-    // we should probably collect all the updatables into a vector before iterating over
-    // them and calling on_update
+    switch (update_phase)
+    {
+    case UpdatePhase::Parallel:
+        return _parallel_updatables;
+    case UpdatePhase::Serial:
+        return _serial_updatables;
+    }
 
-    for (auto updatable : _updatables)
-        updatable->on_update();
+    assert(false);
+    std::unreachable();
 }
 
 } // namespace zth
@@ -40,6 +40,21 @@ bool write_to_file(const std::filesystem::path& path, std::string_view content)
     return true;
 }
 
+bool write_to_file(const std::filesystem::path& path, std::span<const u8> content)
+{
+    std::ofstream file(path, std::ios::binary);
+
+    if (!file.good()) [[unlikely]]
+        return false;
+
+    file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+
+    if (!file.good()) [[unlikely]]
+        return false;
+
+    return true;
+}
+
 bool append_to_file(const std::filesystem::path& path, std::string_view content)
 {
     std::ofstream file(path, std::ios::app);
@@ -1,8 +1,7 @@
 #include "Zenith/Graphics/CustomPrimitiveRenderer.hpp"
 
-#include <stack>
-
 #include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Rasterizer.hpp"
 
 namespace zth {
 
@@ -62,15 +61,29 @@ void CustomPrimitiveRenderer::draw_triangle_impl(const Triangle& triangle, const
 
 void CustomPrimitiveRenderer::draw_filled_triangle_impl(const Triangle& triangle, const Color& color)
 {
-    const auto render_target_size = _render_target.getSize();
-    auto& image = get_tmp_image(render_target_size);
+    auto get_mask_key = [&](const Vec2f& translation, std::vector<float>& key) {
+        for (const auto& point : triangle.translated(translation).points)
+            key.insert(key.end(), { point.x, point.y });
+    };
 
-    draw_triangle_on_image(image, triangle, color);
+    auto rasterize = [&](sf::Image& image, const Vec2f& translation, const Color& fill_color) {
+        auto local_triangle = triangle.translated(translation);
+        auto rasterizer = get_rasterizer(image);
 
-    auto seed = get_triangle_seed(triangle);
-    fill_on_image(image, seed, color, color, Color::transparent);
+        if (fill_algorithm == FillAlgorithm::Scanline)
+        {
+            rasterizer.fill_convex_polygon(local_triangle.points, fill_color);
+        }
+        else
+        {
+            rasterizer.draw_triangle(local_triangle, fill_color);
 
-    draw_image(image);
+            auto seed = get_triangle_seed(local_triangle);
+            fill_on_image(image, seed, fill_color, fill_color, Color::transparent);
+        }
+    };
+
+    draw_filled_shape(triangle.bounds(), FilledShapeType::Triangle, color, get_mask_key, rasterize);
 }
 
 void CustomPrimitiveRenderer::draw_rect_impl(const Rect& rect, const Color& color)
@@ -81,15 +94,29 @@ void CustomPrimitiveRenderer::draw_rect_impl(const Rect& rect, const Color& colo
 
 void CustomPrimitiveRenderer::draw_filled_rect_impl(const Rect& rect, const Color& color)
 {
-    const auto render_target_size = _render_target.getSize();
-    auto& image = get_tmp_image(render_target_size);
+    auto get_mask_key = [&](const Vec2f& translation, std::vector<float>& key) {
+        auto local_rect = rect.translated(translation);
+        key.insert(key.end(), { local_rect.position.x, local_rect.position.y, local_rect.size.x, local_rect.size.y });
+    };
+
+    auto rasterize = [&](sf::Image& image, const Vec2f& translation, const Color& fill_color) {
+        auto local_rect = rect.translated(translation);
+        auto rasterizer = get_rasterizer(image);
 
-    draw_rect_on_image(image, rect, color);
+        if (fill_algorithm == FillAlgorithm::Scanline)
+        {
+            rasterizer.fill_rect(local_rect, fill_color);
+        }
+        else
+        {
+            rasterizer.draw_rect(local_rect, fill_color);
 
-    auto seed = get_rect_seed(rect);
-    fill_on_image(image, seed, color, color, Color::transparent);
+            auto seed = get_rect_seed(local_rect);
+            fill_on_image(image, seed, fill_color, fill_color, Color::transparent);
+        }
+    };
 
-    draw_image(image);
+    draw_filled_shape(rect, FilledShapeType::Rect, color, get_mask_key, rasterize);
 }
 
 void CustomPrimitiveRenderer::draw_convex_polygon_impl(std::span<const Vec2f> points, const Color& color)
@@ -108,29 +135,73 @@ void CustomPrimitiveRenderer::draw_convex_polygon_impl(std::span<const Line> lin
 
 void CustomPrimitiveRenderer::draw_filled_convex_polygon_impl(std::span<const Vec2f> points, const Color& color)
 {
-    const auto render_target_size = _render_target.getSize();
-    auto& image = get_tmp_image(render_target_size);
+    auto get_mask_key = [&](const Vec2f& translation, std::vector<float>& key) {
+        for (const auto& point : points)
+        {
+            auto local_point = point.translated(translation);
+            key.insert(key.end(), { local_point.x, local_point.y });
+        }
+    };
+
+    auto rasterize = [&](sf::Image& image, const Vec2f& translation, const Color& fill_color) {
+        auto& local_points = _local_points;
+        local_points.clear();
+        std::ranges::transform(points, std::back_inserter(local_points),
+                               [&](auto& point) { return point.translated(translation); });
 
-    draw_line_strip_on_image(image, points, color);
-    draw_line_on_image(image, points.back(), points.front(), color);
+        auto rasterizer = get_rasterizer(image);
 
-    auto seed = get_convex_polygon_seed(points);
-    fill_on_image(image, seed, color, color, Color::transparent);
+        if (fill_algorithm == FillAlgorithm::Scanline)
+        {
+            rasterizer.fill_convex_polygon(local_points, fill_color);
+        }
+        else
+        {
+            rasterizer.draw_line_strip(local_points, fill_color);
+            rasterizer.draw_line(local_points.back(), local_points.front(), fill_color);
 
-    draw_image(image);
+            auto seed = get_convex_polygon_seed(local_points);
+            fill_on_image(image, seed, fill_color, fill_color, Color::transparent);
+        }
+    };
+
+    draw_filled_shape(get_convex_polygon_bounds(points), FilledShapeType::ConvexPolygon, color, get_mask_key,
+                      rasterize);
 }
 
 void CustomPrimitiveRenderer::draw_filled_convex_polygon_impl(std::span<const Line> lines, const Color& color)
 {
-    const auto render_target_size = _render_target.getSize();
-    auto& image = get_tmp_image(render_target_size);
+    auto get_mask_key = [&](const Vec2f& translation, std::vector<float>& key) {
+        for (const auto& line : lines)
+        {
+            auto local_line = line.translated(translation);
+            key.insert(key.end(), { local_line.from.x, local_line.from.y, local_line.to.x, local_line.to.y });
+        }
+    };
 
-    draw_lines_on_image(image, lines, color);
+    auto rasterize = [&](sf::Image& image, const Vec2f& translation, const Color& fill_color) {
+        auto& local_lines = _local_lines;
+        local_lines.clear();
+        std::ranges::transform(lines, std::back_inserter(local_lines),
+                               [&](auto& line) { return line.translated(translation); });
 
-    auto seed = get_convex_polygon_seed(lines);
-    fill_on_image(image, seed, color, color, Color::transparent);
+        auto rasterizer = get_rasterizer(image);
 
-    draw_image(image);
+        if (fill_algorithm == FillAlgorithm::Scanline)
+        {
+            rasterizer.fill_convex_polygon(local_lines, fill_color);
+        }
+        else
+        {
+            rasterizer.draw_lines(local_lines, fill_color);
+
+            auto seed = get_convex_polygon_seed(local_lines);
+            fill_on_image(image, seed, fill_color, fill_color, Color::transparent);
+        }
+    };
+
+    draw_filled_shape(get_convex_polygon_bounds(lines), FilledShapeType::ConvexPolygonLines, color, get_mask_key,
+                      rasterize);
 }
 
 void CustomPrimitiveRenderer::draw_circle_impl(const Circle& circle, const Color& color)
@@ -147,32 +218,92 @@ void CustomPrimitiveRenderer::draw_ellipse_impl(const Ellipse& ellipse, const Co
 
 void CustomPrimitiveRenderer::draw_filled_circle_impl(const Circle& circle, const Color& color)
 {
-    const auto render_target_size = _render_target.getSize();
-    auto& image = get_tmp_image(render_target_size);
+    auto get_mask_key = [&](const Vec2f& translation, std::vector<float>& key) {
+        auto local_circle = circle.translated(translation);
+        key.insert(key.end(), { local_circle.center.x, local_circle.center.y, local_circle.radius });
+    };
+
+    auto rasterize = [&](sf::Image& image, const Vec2f& translation, const Color& fill_color) {
+        auto local_circle = circle.translated(translation);
+        auto rasterizer = get_rasterizer(image);
 
-    draw_circle_on_image(image, circle, color);
+        if (fill_algorithm == FillAlgorithm::Scanline)
+        {
+            rasterizer.fill_circle(local_circle, fill_color);
+        }
+        else
+        {
+            rasterizer.draw_circle(local_circle, fill_color);
 
-    auto seed = get_circle_seed(circle);
-    fill_on_image(image, seed, color, color, Color::transparent);
+            auto seed = get_circle_seed(local_circle);
+            fill_on_image(image, seed, fill_color, fill_color, Color::transparent);
+        }
+    };
 
-    draw_image(image);
+    draw_filled_shape(circle.bounds(), FilledShapeType::Circle, color, get_mask_key, rasterize);
 }
 
 void CustomPrimitiveRenderer::draw_filled_ellipse_impl(const Ellipse& ellipse, const Color& color)
 {
-    const auto render_target_size = _render_target.getSize();
-    auto& image = get_tmp_image(render_target_size);
+    auto get_mask_key = [&](const Vec2f& translation, std::vector<float>& key) {
+        auto local_ellipse = ellipse.translated(translation);
+        key.insert(key.end(),
+                   { local_ellipse.center.x, local_ellipse.center.y, local_ellipse.radius.x, local_ellipse.radius.y });
+    };
+
+    auto rasterize = [&](sf::Image& image, const Vec2f& translation, const Color& fill_color) {
+        auto local_ellipse = ellipse.translated(translation);
+        auto rasterizer = get_rasterizer(image);
+
+        if (fill_algorithm == FillAlgorithm::Scanline)
+        {
+            rasterizer.fill_ellipse(local_ellipse, fill_color);
+        }
+        else
+        {
+            rasterizer.draw_ellipse(local_ellipse, fill_color);
+
+            auto seed = get_ellipse_seed(local_ellipse);
+            fill_on_image(image, seed, fill_color, fill_color, Color::transparent);
+        }
+    };
+
+    draw_filled_shape(ellipse.bounds(), FilledShapeType::Ellipse, color, get_mask_key, rasterize);
+}
+
+void CustomPrimitiveRenderer::flush_impl()
+{
+    // a headless renderer draws straight into the target framebuffer, so there's nothing to present
+    if (!_framebuffer_in_use)
+        return;
+
+    _framebuffer_in_use = false;
+
+    const auto framebuffer_size = _framebuffer.getSize();
 
-    draw_ellipse_on_image(image, ellipse, color);
+    if (!_framebuffer_texture)
+        _framebuffer_texture.emplace();
+
+    if (_framebuffer_texture->getSize() != framebuffer_size)
+    {
+        if (!_framebuffer_texture->create(framebuffer_size.x, framebuffer_size.y))
+            return;
+    }
 
-    auto seed = get_ellipse_seed(ellipse);
-    fill_on_image(image, seed, color, color, Color::transparent);
+    _framebuffer_texture->update(_framebuffer);
 
-    draw_image(image);
+    sf::Sprite sprite(*_framebuffer_texture);
+    _render_target->draw(sprite);
 }
 
 void CustomPrimitiveRenderer::plot_point(const Vec2f& point, const Color& color)
 {
+    if (get_render_mode() == RenderMode::Immediate && pixel_output == PixelOutput::Spans)
+    {
+        _plotted_pixels.push_back({ to_pixel(point), color });
+        return;
+    }
+
     _vertex_array.append({ point, color });
 }
 
@@ -184,45 +315,13 @@ void CustomPrimitiveRenderer::plot_points(std::span<const Vec2f> points, const C
 
 void CustomPrimitiveRenderer::plot_line(const Vec2f& from, const Vec2f& to, const Color& color)
 {
-    auto [delta_x, delta_y] = to - from;
-    float slope = delta_y / delta_x;
-
-    if (slope > 1.0f || slope < -1.0f)
-    {
-        // we're drawing a point for every y coord and calculating the corresponding x coord
-        slope = 1.0f / slope;
-
-        const auto& [start_point, end_point] =
-            std::minmax(from, to, [](auto& from, auto& to) { return from.y <= to.y; });
+    auto line = clip_line(from, to, get_target_size());
 
-        float x = start_point.x;
-        i32 y = static_cast<i32>(start_point.y);
-        i32 end_y = static_cast<i32>(end_point.y);
-        assert(y <= end_y);
-
-        for (; y <= end_y; y++)
-        {
-            plot_point({ x, static_cast<float>(y) }, color);
-            x += slope;
-        }
-    }
-    else
-    {
-        // we're drawing a point for every x coord and calculating the corresponding y coord
-        const auto& [start_point, end_point] =
-            std::minmax(from, to, [](auto& from, auto& to) { return from.x <= to.x; });
-
-        i32 x = static_cast<i32>(start_point.x);
-        i32 end_x = static_cast<i32>(end_point.x);
-        float y = start_point.y;
-        assert(x <= end_x);
+    // lines lying entirely off screen don't get rasterized at all
+    if (!line)
+        return;
 
-        for (; x <= end_x; x++)
-        {
-            plot_point({ static_cast<float>(x), y }, color);
-            y += slope;
-        }
-    }
+    bresenham_line(*line, [&](i32 x, i32 y) { plot_point({ static_cast<float>(x), static_cast<float>(y) }, color); });
 }
 
 void CustomPrimitiveRenderer::plot_line(const Line& line, const Color& color)
@@ -296,370 +395,391 @@ void CustomPrimitiveRenderer::plot_convex_polygon(std::span<const Line> lines, c
 
 void CustomPrimitiveRenderer::plot_circle(const Circle& circle, const Color& color)
 {
-    constexpr auto pi = std::numbers::pi_v<float>;
-
-    auto [xc, yc] = circle.center;
-    float step = std::min(1.0f / circle.radius, 1.0f);
-    usize iterations = static_cast<usize>(pi / 4.0f / step) + 1;
-    float alpha = 0.0f;
-
-    for (usize i = 0; i < iterations; i++)
-    {
-        float x = circle.radius * std::cos(alpha);
-        float y = circle.radius * std::sin(alpha);
-
-        std::array points = {
-            Vec2f{ xc + x, yc + y }, Vec2f{ xc + x, yc - y }, Vec2f{ xc - x, yc + y }, Vec2f{ xc - x, yc - y },
-            Vec2f{ xc + y, yc + x }, Vec2f{ xc + y, yc - x }, Vec2f{ xc - y, yc + x }, Vec2f{ xc - y, yc - x },
-        };
-
-        plot_points(points, color);
-        alpha += step;
-    }
+    plot_ellipse(Ellipse{ circle.center, { circle.radius, circle.radius } }, color);
 }
 
 void CustomPrimitiveRenderer::plot_ellipse(const Ellipse& ellipse, const Color& color)
 {
-    constexpr auto pi = std::numbers::pi_v<float>;
-
-    auto [xc, yc] = ellipse.center;
-    float step = 1.0f / std::max(ellipse.radius.x, ellipse.radius.y);
-    step = std::min(step, 1.0f);
-    usize iterations = static_cast<usize>(pi / 2.0f / step) + 1;
-    float alpha = 0.0f;
-
-    for (usize i = 0; i < iterations; i++)
-    {
-        float x = ellipse.radius.x * std::cos(alpha);
-        float y = ellipse.radius.y * std::sin(alpha);
-
-        std::array points = {
-            Vec2f{ xc + x, yc + y },
-            Vec2f{ xc + x, yc - y },
-            Vec2f{ xc - x, yc + y },
-            Vec2f{ xc - x, yc - y },
-        };
-
-        plot_points(points, color);
-        alpha += step;
-    }
-}
-
-void CustomPrimitiveRenderer::draw_line_on_image(sf::Image& image, const Vec2f& from, const Vec2f& to,
-                                                 const Color& color)
-{
-    // TODO: make sure the calculated points fit within the image
-
-    const auto sf_color = static_cast<sf::Color>(color);
+    // ellipses lying entirely off screen don't get rasterized at all
+    if (!get_raster_bounds(ellipse.bounds()))
+        return;
 
-    auto [delta_x, delta_y] = to - from;
-    float slope = delta_y / delta_x;
+    const auto render_target_size = static_cast<Vec2i>(get_target_size());
 
-    if (slope > 1.0f || slope < -1.0f)
-    {
-        // we're drawing a point for every y coord and calculating the corresponding x coord
-        slope = 1.0f / slope;
+    auto plot = [&](i32 x, i32 y) {
+        if (x < 0 || y < 0 || x >= render_target_size.x || y >= render_target_size.y)
+            return;
 
-        const auto& [start_point, end_point] =
-            std::minmax(from, to, [](auto& from, auto& to) { return from.y <= to.y; });
+        plot_point({ static_cast<float>(x), static_cast<float>(y) }, color);
+    };
 
-        float x = start_point.x;
-        u32 y = static_cast<u32>(start_point.y);
-        u32 end_y = static_cast<u32>(end_point.y);
-        assert(y <= end_y);
+    auto center = to_pixel(ellipse.center);
 
-        for (; y <= end_y; y++)
-        {
-            image.setPixel(static_cast<u32>(x), y, sf_color);
-            x += slope;
-        }
-    }
+    if (ellipse.radius.x == ellipse.radius.y)
+        midpoint_circle(center, to_pixel_radius(ellipse.radius.x), plot);
     else
-    {
-        // we're drawing a point for every x coord and calculating the corresponding y coord
-        const auto& [start_point, end_point] =
-            std::minmax(from, to, [](auto& from, auto& to) { return from.x <= to.x; });
-
-        u32 x = static_cast<u32>(start_point.x);
-        u32 end_x = static_cast<u32>(end_point.x);
-        float y = start_point.y;
-        assert(x <= end_x);
-
-        for (; x <= end_x; x++)
-        {
-            image.setPixel(x, static_cast<u32>(y), sf_color);
-            y += slope;
-        }
-    }
+        midpoint_ellipse(center, { to_pixel_radius(ellipse.radius.x), to_pixel_radius(ellipse.radius.y) }, plot);
 }
 
-void CustomPrimitiveRenderer::draw_line_on_image(sf::Image& image, const Line& line, const Color& color)
+Rect CustomPrimitiveRenderer::get_convex_polygon_bounds(std::span<const Vec2f> points)
 {
-    draw_line_on_image(image, line.from, line.to, color);
-}
+    auto [min_x, max_x] = std::ranges::minmax(points | std::views::transform(&Vec2f::x));
+    auto [min_y, max_y] = std::ranges::minmax(points | std::views::transform(&Vec2f::y));
 
-void CustomPrimitiveRenderer::draw_line_strip_on_image(sf::Image& image, std::span<const Vec2f> points,
-                                                       const Color& color)
-{
-    for (const auto line : points | std::views::adjacent<2>)
-    {
-        const auto& [from, to] = line;
-        draw_line_on_image(image, from, to, color);
-    }
+    return { { min_x, min_y }, { max_x - min_x, max_y - min_y } };
 }
 
-void CustomPrimitiveRenderer::draw_lines_on_image(sf::Image& image, std::span<const Line> lines, const Color& color)
+Rect CustomPrimitiveRenderer::get_convex_polygon_bounds(std::span<const Line> lines)
 {
-    for (const auto& line : lines)
-        draw_line_on_image(image, line, color);
-}
+    // the lines are connected, so every point of the polygon is the start of some line
+    auto [min_x, max_x] = std::ranges::minmax(lines | std::views::transform([](auto& line) { return line.from.x; }));
+    auto [min_y, max_y] = std::ranges::minmax(lines | std::views::transform([](auto& line) { return line.from.y; }));
 
-void CustomPrimitiveRenderer::draw_triangle_on_image(sf::Image& image, const Triangle& triangle, const Color& color)
-{
-    draw_line_strip_on_image(image, triangle.points, color);
-    draw_line_on_image(image, triangle.points.back(), triangle.points.front(), color);
-}
-
-void CustomPrimitiveRenderer::draw_rect_on_image(sf::Image& image, const Rect& rect, const Color& color)
-{
-    auto points = rect.points();
-    draw_line_strip_on_image(image, points, color);
-    draw_line_on_image(image, points.back(), points.front(), color);
+    return { { min_x, min_y }, { max_x - min_x, max_y - min_y } };
 }
 
-void CustomPrimitiveRenderer::draw_circle_on_image(sf::Image& image, const Circle& circle, const Color& color)
-{
-    // TODO: make sure the calculated points fit within the image
-
-    const auto sf_color = static_cast<sf::Color>(color);
-    constexpr auto pi = std::numbers::pi_v<float>;
-
-    u32 xc = static_cast<u32>(circle.center.x);
-    u32 yc = static_cast<u32>(circle.center.y);
-    float step = std::min(1.0f / circle.radius, 1.0f);
-    usize iterations = static_cast<usize>(pi / 4.0f / step) + 1;
-    float alpha = 0.0f;
-
-    for (usize i = 0; i < iterations; i++)
-    {
-        u32 x = static_cast<u32>(circle.radius * std::cos(alpha));
-        u32 y = static_cast<u32>(circle.radius * std::sin(alpha));
-
-        image.setPixel(xc + x, yc + y, sf_color);
-        image.setPixel(xc + x, yc - y, sf_color);
-        image.setPixel(xc - x, yc + y, sf_color);
-        image.setPixel(xc - x, yc - y, sf_color);
-        image.setPixel(xc + y, yc + x, sf_color);
-        image.setPixel(xc + y, yc - x, sf_color);
-        image.setPixel(xc - y, yc + x, sf_color);
-        image.setPixel(xc - y, yc - x, sf_color);
-
-        alpha += step;
-    }
-}
-
-void CustomPrimitiveRenderer::draw_ellipse_on_image(sf::Image& image, const Ellipse& ellipse, const Color& color)
-{
-    // TODO: make sure the calculated points fit within the image
-
-    const auto sf_color = static_cast<sf::Color>(color);
-    constexpr auto pi = std::numbers::pi_v<float>;
-
-    u32 xc = static_cast<u32>(ellipse.center.x);
-    u32 yc = static_cast<u32>(ellipse.center.y);
-    float step = 1.0f / std::max(ellipse.radius.x, ellipse.radius.y);
-    step = std::min(step, 1.0f);
-    usize iterations = static_cast<usize>(pi / 2.0f / step) + 1;
-    float alpha = 0.0f;
-
-    for (usize i = 0; i < iterations; i++)
-    {
-        u32 x = static_cast<u32>(ellipse.radius.x * std::cos(alpha));
-        u32 y = static_cast<u32>(ellipse.radius.y * std::sin(alpha));
-
-        image.setPixel(xc + x, yc + y, sf_color);
-        image.setPixel(xc + x, yc - y, sf_color);
-        image.setPixel(xc - x, yc + y, sf_color);
-        image.setPixel(xc - x, yc - y, sf_color);
-
-        alpha += step;
-    }
-}
-
-Vec2u CustomPrimitiveRenderer::get_triangle_seed(const Triangle& triangle)
+Vec2i CustomPrimitiveRenderer::get_triangle_seed(const Triangle& triangle)
 {
     const auto& points = triangle.points;
     auto points_sum = std::reduce(points.begin(), points.end(), Vec2f{ 0.0f, 0.0f });
     auto points_average = points_sum / static_cast<float>(points.size());
-    auto seed = static_cast<Vec2u>(points_average);
+    auto seed = to_pixel(points_average);
 
     return seed;
 }
 
-Vec2u CustomPrimitiveRenderer::get_rect_seed(const Rect& rect)
+Vec2i CustomPrimitiveRenderer::get_rect_seed(const Rect& rect)
 {
     auto top_left = rect.position;
     auto bottom_right = rect.position + rect.size;
 
     // get the middle of the diagonal as the starting point
-    auto seed = static_cast<Vec2u>((top_left + bottom_right) / 2.0f);
+    auto seed = to_pixel((top_left + bottom_right) / 2.0f);
 
     return seed;
 }
 
-Vec2u CustomPrimitiveRenderer::get_convex_polygon_seed(std::span<const Vec2f> points)
+Vec2i CustomPrimitiveRenderer::get_convex_polygon_seed(std::span<const Vec2f> points)
 {
     auto points_sum = std::reduce(points.begin(), points.end(), Vec2f{ 0.0f, 0.0f });
     auto points_average = points_sum / static_cast<float>(points.size());
-    auto seed = static_cast<Vec2u>(points_average);
+    auto seed = to_pixel(points_average);
 
     return seed;
 }
 
-Vec2u CustomPrimitiveRenderer::get_convex_polygon_seed(std::span<const Line> lines)
+Vec2i CustomPrimitiveRenderer::get_convex_polygon_seed(std::span<const Line> lines)
 {
     auto points_sum = std::transform_reduce(lines.begin(), lines.end(), Vec2f{ 0.0f, 0.0f }, std::plus{},
                                             [](auto& line) { return line.from; });
     auto points_average = points_sum / static_cast<float>(lines.size());
-    auto seed = static_cast<Vec2u>(points_average);
+    auto seed = to_pixel(points_average);
 
     return seed;
 }
 
-Vec2u CustomPrimitiveRenderer::get_circle_seed(const Circle& circle)
+Vec2i CustomPrimitiveRenderer::get_circle_seed(const Circle& circle)
 {
-    auto seed = static_cast<Vec2u>(circle.center);
+    auto seed = to_pixel(circle.center);
     return seed;
 }
 
-Vec2u CustomPrimitiveRenderer::get_ellipse_seed(const Ellipse& ellipse)
+Vec2i CustomPrimitiveRenderer::get_ellipse_seed(const Ellipse& ellipse)
 {
-    auto seed = static_cast<Vec2u>(ellipse.center);
+    auto seed = to_pixel(ellipse.center);
     return seed;
 }
 
-void CustomPrimitiveRenderer::boundary_fill_on_image(sf::Image& image, const Vec2u& seed, const Color& border_color,
-                                                     const Color& fill_color)
+void CustomPrimitiveRenderer::fill_on_image(sf::Image& image, const Vec2i& seed, const Color& border_color,
+                                            const Color& fill_color, const Color& background_color)
 {
-    const auto image_size = image.getSize();
-
-    std::stack<Vec2u> stack;
-    stack.emplace(seed.x, seed.y);
+    // the seed can end up outside of the image, even at negative coordinates, when the shape is clipped by the render
+    // target, the rasterizer skips such fills
+    ImageRasterizer rasterizer{ image };
 
-    while (!stack.empty())
+    switch (fill_algorithm)
     {
-        auto x = stack.top().x;
-        auto y = stack.top().y;
+    case FillAlgorithm::Scanline:
+        // scanline fills work straight from the shape's edges and don't need a seed
+        assert(false);
+        break;
+    case FillAlgorithm::BoundaryFill:
+        rasterizer.boundary_fill(seed, border_color, fill_color, _fill_stack);
+        break;
+    case FillAlgorithm::FloodFill:
+        rasterizer.flood_fill(seed, fill_color, background_color, _fill_stack);
+        break;
+    }
+}
 
-        stack.pop();
+template<typename GetMaskKeyFn, typename RasterizeFn>
+void CustomPrimitiveRenderer::draw_filled_shape(const Rect& bounds, FilledShapeType shape_type, const Color& color,
+                                                GetMaskKeyFn&& get_mask_key, RasterizeFn&& rasterize)
+{
+    auto raster_bounds = get_raster_bounds(bounds);
 
-        auto pixel_color = image.getPixel(x, y);
+    if (!raster_bounds)
+        return;
 
-        if (pixel_color == static_cast<sf::Color>(fill_color))
-            continue;
+    // only shapes lying entirely within the render target get cached, so that the masks never contain pixels which
+    // can't be drawn and seed fills always see the whole outline
+    if (shape_mask_cache.memory_budget() > 0 && is_within_target(bounds))
+    {
+        const auto translation = -static_cast<Vec2f>(raster_bounds->position);
 
-        if (pixel_color == static_cast<sf::Color>(border_color))
-            continue;
+        _mask_key.clear();
+        get_mask_key(translation, _mask_key);
 
-        image.setPixel(x, y, static_cast<sf::Color>(fill_color));
+        const auto kind = static_cast<u32>(shape_type) << 8 | static_cast<u32>(fill_algorithm);
+        const auto* mask = shape_mask_cache.find(kind, _mask_key);
 
-        if (y > 1)
-            stack.emplace(x, y - 1);
+        if (!mask)
+        {
+            // the mask records the coverage only, so the shape is rasterized with an opaque color
+            auto& image = get_tmp_image(*raster_bounds);
+            rasterize(image, translation, Color::white);
 
-        if (x < image_size.x - 1)
-            stack.emplace(x + 1, y);
+            _shape_mask = create_shape_mask(image);
+            shape_mask_cache.insert(kind, _mask_key, _shape_mask);
+            mask = &_shape_mask;
+        }
 
-        if (y < image_size.y - 1)
-            stack.emplace(x, y + 1);
+        draw_shape_mask(*mask, raster_bounds->position, color);
+        return;
+    }
 
-        if (x > 1)
-            stack.emplace(x - 1, y);
+    if (get_render_mode() == RenderMode::Deferred && fill_algorithm == FillAlgorithm::Scanline)
+    {
+        // scanline fills only touch the shape's own pixels, so they can go straight into the framebuffer
+        rasterize(get_framebuffer(), Vec2f{ 0.0f, 0.0f }, color);
+        return;
     }
+
+    // seed fills need an image that contains nothing but the shape's outline
+    auto& image = get_tmp_image(*raster_bounds);
+    rasterize(image, -static_cast<Vec2f>(raster_bounds->position), color);
+    draw_shape_image(image, raster_bounds->position);
 }
 
-void CustomPrimitiveRenderer::flood_fill_on_image(sf::Image& image, const Vec2u& seed, const Color& fill_color,
-                                                  const Color& background_color)
+void CustomPrimitiveRenderer::draw_shape_mask(const ShapeMask& mask, const Vec2i& position, const Color& color)
 {
-    const auto image_size = image.getSize();
+    // the mask already holds the pixels the shape covers, whichever fill algorithm it was rasterized with, and its
+    // spans never overlap, so they can go straight to the target without another round through an image
+    switch (get_render_mode())
+    {
+    case RenderMode::Immediate:
+        for (const auto& span : mask.spans)
+            append_span({ position.x + span.x_start, position.y + span.y }, span.x_end - span.x_start + 1, color);
+
+        draw_span_vertices();
+        return;
+    case RenderMode::Deferred:
+    {
+        ImageRasterizer rasterizer{ get_framebuffer() };
+        rasterizer.blend = true;
 
-    std::stack<Vec2u> stack;
-    stack.emplace(seed.x, seed.y);
+        for (const auto& span : mask.spans)
+            rasterizer.fill_span(position.y + span.y, position.x + span.x_start, position.x + span.x_end, color);
 
-    while (!stack.empty())
+        return;
+    }
+    }
+
+    assert(false);
+    std::unreachable();
+}
+
+void CustomPrimitiveRenderer::draw_shape_image(const sf::Image& image, const Vec2i& position)
+{
+    switch (get_render_mode())
     {
-        auto x = stack.top().x;
-        auto y = stack.top().y;
-        stack.pop();
+    case RenderMode::Immediate:
+        draw_image(image, position);
+        break;
+    case RenderMode::Deferred:
+        blend_image(get_framebuffer(), image, position);
+        break;
+    }
+}
 
-        auto pixel_color = image.getPixel(x, y);
+bool CustomPrimitiveRenderer::is_within_target(const Rect& bounds) const
+{
+    const auto target_size = static_cast<Vec2f>(get_target_size());
 
-        if (pixel_color == static_cast<sf::Color>(fill_color))
-            continue;
+    auto [x1, y1] = bounds.position;
+    auto [x2, y2] = bounds.position + bounds.size;
 
-        if (pixel_color != static_cast<sf::Color>(background_color))
-            continue;
+    return std::min(x1, x2) >= 0.0f && std::min(y1, y2) >= 0.0f && std::max(x1, x2) < target_size.x
+           && std::max(y1, y2) < target_size.y;
+}
 
-        image.setPixel(x, y, static_cast<sf::Color>(fill_color));
+std::optional<IntRect> CustomPrimitiveRenderer::get_raster_bounds(const Rect& bounds) const
+{
+    return zth::get_raster_bounds(bounds, get_target_size());
+}
 
-        if (y > 1)
-            stack.emplace(x, y - 1);
+void CustomPrimitiveRenderer::draw_image(const sf::Image& image, const Vec2i& position)
+{
+    const auto image_size = image.getSize();
 
-        if (x < image_size.x - 1)
-            stack.emplace(x + 1, y);
+    if (!_tmp_texture)
+        _tmp_texture.emplace();
 
-        if (y < image_size.y - 1)
-            stack.emplace(x, y + 1);
+    const auto texture_size = _tmp_texture->getSize();
 
-        if (x > 1)
-            stack.emplace(x - 1, y);
+    if (image_size.x > texture_size.x || image_size.y > texture_size.y)
+    {
+        if (!_tmp_texture->create(std::max(image_size.x, texture_size.x), std::max(image_size.y, texture_size.y)))
+            return;
     }
+
+    // only the part of the texture covered by the image gets uploaded and drawn
+    _tmp_texture->update(image);
+
+    sf::Sprite sprite(*_tmp_texture, { 0, 0, static_cast<i32>(image_size.x), static_cast<i32>(image_size.y) });
+    sprite.setPosition(static_cast<sf::Vector2f>(static_cast<Vec2f>(position)));
+    _render_target->draw(sprite);
 }
 
-void CustomPrimitiveRenderer::fill_on_image(sf::Image& image, const Vec2u& seed, const Color& border_color,
-                                            const Color& fill_color, const Color& background_color) const
+RenderMode CustomPrimitiveRenderer::get_render_mode() const
 {
-    switch (fill_algorithm)
+    // there's no render target to draw to immediately when rendering headlessly
+    if (_target_framebuffer)
+        return RenderMode::Deferred;
+
+    return render_mode;
+}
+
+Vec2u CustomPrimitiveRenderer::get_target_size() const
+{
+    if (_target_framebuffer)
+        return _target_framebuffer->size();
+
+    return Vec2u{ _render_target->getSize() };
+}
+
+sf::Image& CustomPrimitiveRenderer::get_framebuffer()
+{
+    if (_target_framebuffer)
+        return _target_framebuffer->_image;
+
+    // the framebuffer gets cleared lazily by the first primitive drawn after a flush
+    if (!_framebuffer_in_use)
     {
-    case FillAlgorithm::BoundaryFill:
-        boundary_fill_on_image(image, seed, border_color, fill_color);
-        break;
-    case FillAlgorithm::FloodFill:
-        flood_fill_on_image(image, seed, fill_color, background_color);
-        break;
+        const auto render_target_size = get_target_size();
+        _framebuffer.create(render_target_size.x, render_target_size.y, static_cast<sf::Color>(Color::transparent));
+        _framebuffer_in_use = true;
     }
+
+    return _framebuffer;
+}
+
+sf::Image& CustomPrimitiveRenderer::get_tmp_image(const IntRect& raster_bounds)
+{
+    _tmp_image.create(static_cast<u32>(raster_bounds.size.x), static_cast<u32>(raster_bounds.size.y),
+                      static_cast<sf::Color>(Color::transparent));
+
+    return _tmp_image;
 }
 
-void CustomPrimitiveRenderer::draw_image(const sf::Image& image) const
+ImageRasterizer CustomPrimitiveRenderer::get_rasterizer(sf::Image& image)
 {
-    sf::Texture texture;
+    // primitives drawn straight into the framebuffer have to blend the same way as in immediate mode, the scratch
+    // image gets blended as a whole later on
+    ImageRasterizer rasterizer{ image };
+    rasterizer.blend = &image != &_tmp_image;
 
-    if (!texture.loadFromImage(image))
+    return rasterizer;
+}
+
+void CustomPrimitiveRenderer::draw_call()
+{
+    if (get_render_mode() == RenderMode::Deferred)
+    {
+        ImageRasterizer rasterizer{ get_framebuffer() };
+        rasterizer.blend = true;
+
+        for (const auto& vertex : _vertex_array.vertices())
+        {
+            auto [x, y] = to_pixel(vertex.position);
+            rasterizer.set_pixel(x, y, static_cast<sf::Color>(vertex.color));
+        }
+
+        _vertex_array.clear();
         return;
+    }
+
+    if (pixel_output == PixelOutput::Spans)
+    {
+        draw_spans();
+        return;
+    }
 
-    sf::Sprite sprite(texture);
-    _render_target.draw(sprite);
+    _vertex_array.set_primitive_type(PrimitiveType::Points); // we're only ever drawing points in custom renderer
+    _vertex_array.draw_to(*_render_target);
+    _vertex_array.clear();
 }
 
-sf::Image& CustomPrimitiveRenderer::get_tmp_image(const sf::Vector2u& target_size)
+void CustomPrimitiveRenderer::draw_spans()
 {
-    static std::vector<Color> buff;
-    static sf::Image image;
+    // sorting brings the pixels of every row together, no matter the order they were plotted in
+    std::ranges::sort(_plotted_pixels, {}, [](const PlottedPixel& pixel) {
+        return std::pair{ pixel.position.y, pixel.position.x };
+    });
 
-    auto image_size = image.getSize();
+    for (usize span_start = 0; span_start < _plotted_pixels.size();)
+    {
+        const auto& first = _plotted_pixels[span_start];
+        const auto color = static_cast<sf::Color>(first.color);
+        auto span_end_x = first.position.x;
 
-    if (image_size != target_size)
-        buff.assign(static_cast<usize>(target_size.x) * static_cast<usize>(target_size.y), Color::transparent);
+        usize i = span_start + 1;
 
-    image.create(target_size.x, target_size.y, reinterpret_cast<u8*>(buff.data()));
+        // pixels plotted more than once only end up in the span once
+        for (; i < _plotted_pixels.size(); i++)
+        {
+            const auto& pixel = _plotted_pixels[i];
+
+            if (pixel.position.y != first.position.y || pixel.position.x > span_end_x + 1
+                || static_cast<sf::Color>(pixel.color) != color)
+                break;
+
+            span_end_x = pixel.position.x;
+        }
 
-    return image;
+        append_span(first.position, span_end_x - first.position.x + 1, first.color);
+        span_start = i;
+    }
+
+    _plotted_pixels.clear();
+    draw_span_vertices();
 }
 
-void CustomPrimitiveRenderer::draw_call()
+void CustomPrimitiveRenderer::append_span(const Vec2i& start, i32 length, const Color& color)
 {
-    _vertex_array.set_primitive_type(PrimitiveType::Points); // we're only ever drawing points in custom renderer
-    _render_target.draw(_vertex_array._vertex_array);
+    // vertices are placed at pixel centers, so that a line from the center of the first pixel to the center of the
+    // one past the last covers exactly the span
+    Vec2f start_center{ static_cast<float>(start.x) + 0.5f, static_cast<float>(start.y) + 0.5f };
+
+    if (length == 1)
+    {
+        // a lone pixel is cheaper as a point
+        _vertex_array.append({ start_center, color });
+        return;
+    }
+
+    _span_vertex_array.append({ start_center, color });
+    _span_vertex_array.append({ start_center + Vec2f{ static_cast<float>(length), 0.0f }, color });
+}
+
+void CustomPrimitiveRenderer::draw_span_vertices()
+{
+    _vertex_array.set_primitive_type(PrimitiveType::Points);
+    _vertex_array.draw_to(*_render_target);
     _vertex_array.clear();
+
+    _span_vertex_array.draw_to(*_render_target);
+    _span_vertex_array.clear();
 }
 
 } // namespace zth
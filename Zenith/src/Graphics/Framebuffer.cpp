@@ -0,0 +1,49 @@
+#include "Zenith/Graphics/Framebuffer.hpp"
+
+#include "Zenith/Filesystem/FileIo.hpp"
+#include "Zenith/Graphics/PixelKernels.hpp"
+#include "Zenith/Graphics/Rasterizer.hpp"
+
+namespace zth {
+
+Framebuffer::Framebuffer(const Vec2u& size, const Color& color)
+{
+    create(size, color);
+}
+
+void Framebuffer::create(const Vec2u& size, const Color& color)
+{
+    _image.create(size.x, size.y, static_cast<sf::Color>(color));
+}
+
+void Framebuffer::clear(const Color& color)
+{
+    ImageRasterizer rasterizer{ _image };
+    rasterizer.clear(color);
+}
+
+Color Framebuffer::get_pixel(u32 x, u32 y) const
+{
+    auto pixel = _image.getPixel(x, y);
+    return Color{ pixel.r, pixel.g, pixel.b, pixel.a };
+}
+
+std::span<const u8> Framebuffer::pixels() const
+{
+    if (width() == 0 || height() == 0)
+        return {};
+
+    return { _image.getPixelsPtr(), static_cast<usize>(width()) * height() * bytes_per_pixel };
+}
+
+bool Framebuffer::save_to_file(const std::filesystem::path& path) const
+{
+    return _image.saveToFile(path.string());
+}
+
+bool Framebuffer::save_raw(const std::filesystem::path& path) const
+{
+    return write_to_file(path, pixels());
+}
+
+} // namespace zth
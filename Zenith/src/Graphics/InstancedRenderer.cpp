@@ -0,0 +1,394 @@
+#include "Zenith/Graphics/InstancedRenderer.hpp"
+
+#include <SFML/Window/Context.hpp>
+
+#include "Zenith/Graphics/Shaders.hpp"
+#include "Zenith/Graphics/Sprite.hpp"
+#include "Zenith/Logging/Logger.hpp"
+
+#if defined(_WIN32)
+#define ZTH_GL_API __stdcall
+#else
+#define ZTH_GL_API
+#endif
+
+namespace zth {
+
+// sfml only exposes OpenGL 1.1, everything past that is loaded at runtime
+static constexpr u32 gl_unsigned_byte = 0x1401;
+static constexpr u32 gl_float = 0x1406;
+static constexpr u32 gl_triangle_strip = 0x0005;
+static constexpr u32 gl_array_buffer = 0x8892;
+static constexpr u32 gl_stream_draw = 0x88e0;
+static constexpr u32 gl_static_draw = 0x88e4;
+
+static struct
+{
+    void(ZTH_GL_API* viewport)(i32 x, i32 y, i32 width, i32 height);
+    void(ZTH_GL_API* gen_buffers)(i32 count, u32* buffers);
+    void(ZTH_GL_API* delete_buffers)(i32 count, const u32* buffers);
+    void(ZTH_GL_API* bind_buffer)(u32 target, u32 buffer);
+    void(ZTH_GL_API* buffer_data)(u32 target, std::ptrdiff_t size, const void* data, u32 usage);
+    void(ZTH_GL_API* bind_attrib_location)(u32 program, u32 index, const char* name);
+    void(ZTH_GL_API* link_program)(u32 program);
+    i32(ZTH_GL_API* get_attrib_location)(u32 program, const char* name);
+    void(ZTH_GL_API* enable_vertex_attrib_array)(u32 index);
+    void(ZTH_GL_API* disable_vertex_attrib_array)(u32 index);
+    void(ZTH_GL_API* vertex_attrib_pointer)(u32 index, i32 size, u32 type, u8 normalized, i32 stride,
+                                            const void* pointer);
+    void(ZTH_GL_API* vertex_attrib_divisor)(u32 index, u32 divisor);
+    void(ZTH_GL_API* draw_arrays_instanced)(u32 mode, i32 first, i32 count, i32 instance_count);
+} gl;
+
+template<typename Function>
+static bool load_gl_function(Function& function, const char* name, const char* extension_name = nullptr)
+{
+    function = reinterpret_cast<Function>(sf::Context::getFunction(name));
+
+    if (!function && extension_name)
+        function = reinterpret_cast<Function>(sf::Context::getFunction(extension_name));
+
+    return function != nullptr;
+}
+
+static bool load_gl_functions()
+{
+    return load_gl_function(gl.viewport, "glViewport") && load_gl_function(gl.gen_buffers, "glGenBuffers")
+           && load_gl_function(gl.delete_buffers, "glDeleteBuffers")
+           && load_gl_function(gl.bind_buffer, "glBindBuffer") && load_gl_function(gl.buffer_data, "glBufferData")
+           && load_gl_function(gl.bind_attrib_location, "glBindAttribLocation")
+           && load_gl_function(gl.link_program, "glLinkProgram")
+           && load_gl_function(gl.get_attrib_location, "glGetAttribLocation")
+           && load_gl_function(gl.enable_vertex_attrib_array, "glEnableVertexAttribArray")
+           && load_gl_function(gl.disable_vertex_attrib_array, "glDisableVertexAttribArray")
+           && load_gl_function(gl.vertex_attrib_pointer, "glVertexAttribPointer")
+           && load_gl_function(gl.vertex_attrib_divisor, "glVertexAttribDivisor", "glVertexAttribDivisorARB")
+           && load_gl_function(gl.draw_arrays_instanced, "glDrawArraysInstanced", "glDrawArraysInstancedARB");
+}
+
+// the order matches the attribute locations stored for every shader
+static constexpr std::array attribute_names = { "a_corner", "a_transform_x", "a_transform_y", "a_color", "a_uv_rect" };
+
+// the shaders are shared by every renderer, so they only need to be relinked once
+static bool instance_shaders_linked = false;
+
+static Shader& get_instance_shader(InstanceKind instance_kind)
+{
+    switch (instance_kind)
+    {
+        using enum InstanceKind;
+    case Rect:
+        return shaders::instanced_rect_shader;
+    case Circle:
+        return shaders::instanced_circle_shader;
+    case Sprite:
+        return shaders::instanced_sprite_shader;
+    }
+
+    assert(false);
+    std::unreachable();
+}
+
+const char* to_string(InstanceKind instance_kind)
+{
+    switch (instance_kind)
+    {
+        using enum InstanceKind;
+    case Rect:
+        return "Rect";
+    case Circle:
+        return "Circle";
+    case Sprite:
+        return "Sprite";
+    }
+
+    assert(false);
+    return "Unknown";
+}
+
+InstancedRenderer::~InstancedRenderer()
+{
+    if (_state != State::Available)
+        return;
+
+    if (!_render_target->setActive(true))
+        return;
+
+    const std::array buffers = { _corner_buffer, _instance_buffer };
+    gl.delete_buffers(static_cast<i32>(buffers.size()), buffers.data());
+}
+
+void InstancedRenderer::draw_rect(const Rect& rect, const Color& color)
+{
+    add_instance(InstanceKind::Rect, nullptr,
+                 {
+                     .transform_x = { rect.size.x, 0.0f, rect.position.x },
+                     .transform_y = { 0.0f, rect.size.y, rect.position.y },
+                     .color = color,
+                     .uv_rect = { 0.0f, 0.0f, 0.0f, 0.0f },
+                 });
+}
+
+void InstancedRenderer::draw_circle(const Circle& circle, const Color& color)
+{
+    const auto diameter = circle.radius * 2.0f;
+
+    add_instance(InstanceKind::Circle, nullptr,
+                 {
+                     .transform_x = { diameter, 0.0f, circle.center.x - circle.radius },
+                     .transform_y = { 0.0f, diameter, circle.center.y - circle.radius },
+                     .color = color,
+                     .uv_rect = { 0.0f, 0.0f, 0.0f, 0.0f },
+                 });
+}
+
+void InstancedRenderer::draw_sprite(const Sprite& sprite)
+{
+    const auto& sf_sprite = sprite._sprite;
+    const auto texture = sf_sprite.getTexture();
+
+    if (!texture || texture->getSize().x == 0 || texture->getSize().y == 0)
+        return;
+
+    const auto bounds = sf_sprite.getLocalBounds();
+    const auto texture_rect = sf_sprite.getTextureRect();
+    const auto matrix = sf_sprite.getTransform().getMatrix();
+    const auto color = sf_sprite.getColor();
+
+    add_instance(InstanceKind::Sprite, texture,
+                 {
+                     .transform_x = { matrix[0] * bounds.width, matrix[4] * bounds.height, matrix[12] },
+                     .transform_y = { matrix[1] * bounds.width, matrix[5] * bounds.height, matrix[13] },
+                     .color = { color.r, color.g, color.b, color.a },
+                     .uv_rect = {
+                         static_cast<float>(texture_rect.left),
+                         static_cast<float>(texture_rect.top),
+                         static_cast<float>(texture_rect.width),
+                         static_cast<float>(texture_rect.height),
+                     },
+                 });
+}
+
+void InstancedRenderer::flush()
+{
+    if (_instances.empty())
+        return;
+
+    if (is_available())
+        draw_instanced();
+    else
+        draw_expanded();
+
+    _draw_call_count++;
+    _instance_count += _instances.size();
+    _instances.clear();
+}
+
+void InstancedRenderer::set_render_target(sf::RenderTarget& render_target)
+{
+    flush();
+    _render_target = &render_target;
+}
+
+bool InstancedRenderer::is_available()
+{
+    if (_state == State::Uninitialized)
+    {
+        _state = init() ? State::Available : State::Unavailable;
+
+        if (_state == State::Unavailable)
+            logger.get_or_init().log_warning("Instanced rendering isn't available, drawing instances as vertices");
+    }
+
+    return _state == State::Available;
+}
+
+void InstancedRenderer::reset_counters()
+{
+    _draw_call_count = 0;
+    _instance_count = 0;
+}
+
+void InstancedRenderer::add_instance(InstanceKind kind, const sf::Texture* texture, const InstanceData& instance)
+{
+    if (!_instances.empty() && (kind != _batch_kind || texture != _batch_texture))
+        flush();
+
+    _batch_kind = kind;
+    _batch_texture = texture;
+    _instances.push_back(instance);
+}
+
+bool InstancedRenderer::init()
+{
+    if (!_render_target->setActive(true) || !sf::Shader::isAvailable() || !load_gl_functions())
+        return false;
+
+    for (usize i = 0; i < _shaders.size(); i++)
+    {
+        auto& [shader, attribute_locations] = _shaders[i];
+        const auto kind = static_cast<InstanceKind>(i);
+
+        shader = &get_instance_shader(kind);
+        const auto program = shader->get_native_handle();
+
+        // the shaders get compiled along with the other built-in ones, a program of 0 means that failed
+        if (program == 0)
+        {
+            logger.get_or_init().log_error("Failed to create the instanced shader for {}", to_string(kind));
+            return false;
+        }
+
+        // some drivers draw nothing unless generic attribute 0 is enabled, so it has to be one of ours
+        if (!instance_shaders_linked)
+        {
+            gl.bind_attrib_location(program, 0, attribute_names[0]);
+            gl.link_program(program);
+        }
+
+        for (usize j = 0; j < attribute_names.size(); j++)
+            attribute_locations[j] = gl.get_attrib_location(program, attribute_names[j]);
+    }
+
+    instance_shaders_linked = true;
+
+    // the corners of the unit square, as a triangle strip
+    static constexpr std::array corners = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+    gl.gen_buffers(1, &_corner_buffer);
+    gl.gen_buffers(1, &_instance_buffer);
+
+    gl.bind_buffer(gl_array_buffer, _corner_buffer);
+    gl.buffer_data(gl_array_buffer, sizeof(corners), corners.data(), gl_static_draw);
+    gl.bind_buffer(gl_array_buffer, 0);
+
+    return true;
+}
+
+void InstancedRenderer::draw_instanced()
+{
+    auto& [shader, attribute_locations] = _shaders[static_cast<usize>(_batch_kind)];
+
+    // sfml sets up the states it expects and forgets the ones it had cached, as they're about to change
+    _render_target->resetGLStates();
+
+    const auto& view = _render_target->getView();
+    const auto viewport = _render_target->getViewport(view);
+    const auto viewport_bottom = static_cast<i32>(_render_target->getSize().y) - (viewport.top + viewport.height);
+    gl.viewport(viewport.left, viewport_bottom, viewport.width, viewport.height);
+
+    const auto matrix = view.getTransform().getMatrix();
+    shader->set_unif<const Vec3f&>("u_view_x", { matrix[0], matrix[4], matrix[12] });
+    shader->set_unif<const Vec3f&>("u_view_y", { matrix[1], matrix[5], matrix[13] });
+
+    if (_batch_kind == InstanceKind::Sprite)
+    {
+        // resetting the states left the first texture unit active
+        shader->set_unif("u_texture", 0);
+        // binding in pixel coordinates loads the texture matrix the vertex shader normalizes the texture rect with
+        sf::Texture::bind(_batch_texture, sf::Texture::Pixels);
+    }
+
+    shader->bind();
+
+    // respecifying the whole buffer lets the driver hand out new memory instead of waiting for the previous draw
+    gl.bind_buffer(gl_array_buffer, _instance_buffer);
+    gl.buffer_data(gl_array_buffer, static_cast<std::ptrdiff_t>(_instances.size() * sizeof(InstanceData)),
+                   _instances.data(), gl_stream_draw);
+
+    auto enable_attribute = [&](usize attribute, i32 size, u32 type, bool normalized, usize offset, u32 divisor) {
+        const auto location = attribute_locations[attribute];
+
+        // attributes unused by the shader get optimized out
+        if (location < 0)
+            return;
+
+        const auto index = static_cast<u32>(location);
+        const auto stride = divisor == 0 ? 0 : static_cast<i32>(sizeof(InstanceData));
+
+        gl.enable_vertex_attrib_array(index);
+        gl.vertex_attrib_pointer(index, size, type, normalized, stride, reinterpret_cast<const void*>(offset));
+        gl.vertex_attrib_divisor(index, divisor);
+    };
+
+    enable_attribute(1, 3, gl_float, false, offsetof(InstanceData, transform_x), 1);
+    enable_attribute(2, 3, gl_float, false, offsetof(InstanceData, transform_y), 1);
+    enable_attribute(3, 4, gl_unsigned_byte, true, offsetof(InstanceData, color), 1);
+    enable_attribute(4, 4, gl_float, false, offsetof(InstanceData, uv_rect), 1);
+
+    gl.bind_buffer(gl_array_buffer, _corner_buffer);
+    enable_attribute(0, 2, gl_float, false, 0, 0);
+
+    gl.draw_arrays_instanced(gl_triangle_strip, 0, 4, static_cast<i32>(_instances.size()));
+
+    for (auto location : attribute_locations)
+    {
+        if (location < 0)
+            continue;
+
+        gl.vertex_attrib_divisor(static_cast<u32>(location), 0);
+        gl.disable_vertex_attrib_array(static_cast<u32>(location));
+    }
+
+    // sfml draws from client memory, which doesn't work with a buffer bound
+    gl.bind_buffer(gl_array_buffer, 0);
+    Shader::unbind();
+    sf::Texture::bind(nullptr);
+    _render_target->resetGLStates();
+}
+
+void InstancedRenderer::draw_expanded()
+{
+    for (const auto& instance : _instances)
+    {
+        const auto& [ax, bx, cx] = instance.transform_x;
+        const auto& [ay, by, cy] = instance.transform_y;
+        const auto& [u, v, uv_width, uv_height] = instance.uv_rect;
+        const auto color = static_cast<sf::Color>(instance.color);
+
+        auto to_vertex = [&](float x, float y) {
+            return sf::Vertex{
+                { ax * x + bx * y + cx, ay * x + by * y + cy },
+                color,
+                { u + x * uv_width, v + y * uv_height },
+            };
+        };
+
+        if (_batch_kind != InstanceKind::Circle)
+        {
+            const auto top_left = to_vertex(0.0f, 0.0f);
+            const auto top_right = to_vertex(1.0f, 0.0f);
+            const auto bottom_left = to_vertex(0.0f, 1.0f);
+            const auto bottom_right = to_vertex(1.0f, 1.0f);
+
+            _fallback_vertices.insert(_fallback_vertices.end(),
+                                      { top_left, top_right, bottom_left, bottom_left, top_right, bottom_right });
+            continue;
+        }
+
+        // the circle is inscribed in the unit square
+        const auto center = to_vertex(0.5f, 0.5f);
+        const auto ring = _unit_circle_cache.get_ring(std::max(std::abs(ax), std::abs(by)) / 2.0f);
+
+        for (usize i = 0; i < ring.size(); i++)
+        {
+            const auto& point = ring[i];
+            const auto& next_point = ring[(i + 1) % ring.size()];
+
+            _fallback_vertices.insert(_fallback_vertices.end(),
+                                      {
+                                          center,
+                                          to_vertex((point.x + 1.0f) / 2.0f, (point.y + 1.0f) / 2.0f),
+                                          to_vertex((next_point.x + 1.0f) / 2.0f, (next_point.y + 1.0f) / 2.0f),
+                                      });
+        }
+    }
+
+    sf::RenderStates states;
+    states.texture = _batch_texture;
+
+    _render_target->draw(_fallback_vertices.data(), _fallback_vertices.size(), sf::PrimitiveType::Triangles, states);
+    _fallback_vertices.clear();
+}
+
+} // namespace zth
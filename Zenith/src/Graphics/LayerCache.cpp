@@ -0,0 +1,140 @@
+#include "Zenith/Graphics/LayerCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Zenith/Graphics/Renderer.hpp"
+
+namespace zth {
+
+void LayerCache::draw(Renderer& renderer) const
+{
+    renderer.draw_layer_cache(*this);
+}
+
+void LayerCache::set_grouped(bool is_grouped)
+{
+    if (is_grouped == _render_queue.is_layer_grouped(layer))
+        return;
+
+    _render_queue.set_layer_grouped(layer, is_grouped);
+    invalidate();
+}
+
+void LayerCache::set_padding(float padding)
+{
+    if (padding == _padding)
+        return;
+
+    _padding = std::max(padding, 0.0f);
+    invalidate();
+}
+
+bool LayerCache::is_up_to_date(const sf::RenderTarget& render_target) const
+{
+    if (!_is_valid || render_target.getSize() != _target_size)
+        return false;
+
+    const auto& view = render_target.getView();
+
+    // the texture maps to the render target pixel for pixel only at the zoom and rotation it was drawn with
+    if (view.getSize() != _target_view.getSize() || view.getRotation() != _target_view.getRotation()
+        || view.getViewport() != _target_view.getViewport())
+        return false;
+
+    // the view can move by up to the padding along each of its (possibly rotated) axes
+    const auto to_view_axes = sf::Transform{}.rotate(-view.getRotation());
+    const auto offset = to_view_axes.transformPoint(view.getCenter() - _view.getCenter());
+    const auto view_size = view.getSize();
+    const auto padded_view_size = _view.getSize();
+
+    return std::abs(offset.x) <= (std::abs(padded_view_size.x) - std::abs(view_size.x)) / 2.0f
+           && std::abs(offset.y) <= (std::abs(padded_view_size.y) - std::abs(view_size.y)) / 2.0f;
+}
+
+void LayerCache::redraw(Renderer& renderer, std::span<Drawable* const> drawables, bool cull_drawables)
+{
+    auto& render_target = renderer.render_target();
+    const auto& target_view = render_target.getView();
+    const auto viewport = render_target.getViewport(target_view);
+
+    _is_valid = false;
+
+    if (viewport.width <= 0 || viewport.height <= 0)
+        return;
+
+    // the padding is a whole number of pixels on each side, so the texture lines up with the pixels of the render
+    // target when the view is centered on it
+    const auto max_size = static_cast<i64>(sf::Texture::getMaximumSize());
+
+    auto get_padded_size = [&](i32 size) {
+        // the padding shrinks if the texture would get bigger than the maximum size
+        auto padding = static_cast<i64>(std::ceil(static_cast<float>(size) * _padding));
+        padding = std::clamp((max_size - size) / 2, i64{ 0 }, padding);
+        return static_cast<u32>(size + 2 * padding);
+    };
+
+    const sf::Vector2u size = { get_padded_size(viewport.width), get_padded_size(viewport.height) };
+
+    if (_render_texture.getSize() != size)
+    {
+        if (!_render_texture.create(size.x, size.y))
+            return;
+    }
+
+    // the padded view keeps the zoom and rotation of the render target's view, only covering more of the world
+    _target_view = target_view;
+    _target_size = render_target.getSize();
+
+    const auto view_size = target_view.getSize();
+
+    _view = target_view;
+    _view.setViewport({ 0.0f, 0.0f, 1.0f, 1.0f });
+    _view.setSize({
+        view_size.x * static_cast<float>(size.x) / static_cast<float>(viewport.width),
+        view_size.y * static_cast<float>(size.y) / static_cast<float>(viewport.height),
+    });
+    _render_texture.setView(_view);
+    _render_texture.clear(sf::Color::Transparent);
+
+    renderer.set_render_target(_render_texture);
+    _bounds = renderer.view_bounds();
+
+    for (const auto& drawable : drawables)
+    {
+        if (drawable->layer != layer)
+            continue;
+
+        if (cull_drawables && !drawable->bounds().intersects(_bounds))
+            continue;
+
+        drawable->submit(_render_queue);
+    }
+
+    _render_queue.execute(renderer);
+    renderer.set_render_target(render_target);
+    _render_texture.display();
+
+    _is_valid = true;
+    _redraw_count++;
+}
+
+void LayerCache::draw_to(sf::RenderTarget& render_target) const
+{
+    // the texture goes where the padded view was in the world, so it's drawn with the render target's own view
+    const auto& texture = _render_texture.getTexture();
+    const auto texture_size = static_cast<sf::Vector2f>(texture.getSize());
+    const auto padded_view_size = _view.getSize();
+
+    sf::Sprite sprite{ texture };
+    sprite.setOrigin({ texture_size.x / 2.0f, texture_size.y / 2.0f });
+    sprite.setPosition(_view.getCenter());
+    sprite.setRotation(_view.getRotation());
+    sprite.setScale(padded_view_size.x / texture_size.x, padded_view_size.y / texture_size.y);
+
+    // the texture was drawn to with alpha blending, so its colors are already multiplied by their alpha
+    const sf::BlendMode premultiplied_alpha{ sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha };
+    render_target.draw(sprite, sf::RenderStates{ premultiplied_alpha });
+}
+
+} // namespace zth
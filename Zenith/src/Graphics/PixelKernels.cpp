@@ -0,0 +1,317 @@
+#include "Zenith/Graphics/PixelKernels.hpp"
+
+#include <bit>
+#include <cstring>
+
+#include "Zenith/Core/Typedefs.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ZTH_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ZTH_TARGET_AVX2
+#else
+#define ZTH_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace zth {
+
+struct PixelKernels
+{
+    PixelKernelSet set;
+    void (*fill)(u8* pixels, usize pixel_count, u32 packed_color);
+    void (*blend)(u8* destination, const u8* source, usize pixel_count);
+    void (*blend_color)(u8* pixels, usize pixel_count, u32 packed_color);
+};
+
+static u32 pack_color(const Color& color)
+{
+    // keeps the in-memory order of the channels regardless of endianness
+    return std::bit_cast<u32>(std::array{ color.r, color.g, color.b, color.a });
+}
+
+static void fill_pixels_scalar(u8* pixels, usize pixel_count, u32 packed_color)
+{
+    for (usize i = 0; i < pixel_count; i++)
+        std::memcpy(pixels + i * bytes_per_pixel, &packed_color, bytes_per_pixel);
+}
+
+static void blend_pixels_scalar(u8* destination, const u8* source, usize pixel_count)
+{
+    for (usize i = 0; i < pixel_count; i++)
+    {
+        const u8* src = source + i * bytes_per_pixel;
+        u8* dst = destination + i * bytes_per_pixel;
+
+        const u32 alpha = src[3];
+        const u32 inverse_alpha = 255 - alpha;
+
+        dst[0] = static_cast<u8>((src[0] * alpha + dst[0] * inverse_alpha) / 255);
+        dst[1] = static_cast<u8>((src[1] * alpha + dst[1] * inverse_alpha) / 255);
+        dst[2] = static_cast<u8>((src[2] * alpha + dst[2] * inverse_alpha) / 255);
+        dst[3] = static_cast<u8>(alpha + dst[3] * inverse_alpha / 255);
+    }
+}
+
+static void blend_color_scalar(u8* pixels, usize pixel_count, u32 packed_color)
+{
+    // blending a single pixel onto each of them gives exactly the same results as blending a whole row
+    for (usize i = 0; i < pixel_count; i++)
+        blend_pixels_scalar(pixels + i * bytes_per_pixel, reinterpret_cast<const u8*>(&packed_color), 1);
+}
+
+#if defined(ZTH_X86_64)
+
+// sse2 is a part of x86-64, so it's always there
+
+static void fill_pixels_sse2(u8* pixels, usize pixel_count, u32 packed_color)
+{
+    const auto color = _mm_set1_epi32(std::bit_cast<i32>(packed_color));
+
+    usize i = 0;
+
+    for (; i + 4 <= pixel_count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * bytes_per_pixel), color);
+
+    fill_pixels_scalar(pixels + i * bytes_per_pixel, pixel_count - i, packed_color);
+}
+
+// the channels are widened to 16 bits, so every pixel takes up 4 lanes of a 64-bit group
+// the alpha lane is blended as (255 * alpha + dst_alpha * (255 - alpha)) / 255, which is exactly
+// alpha + dst_alpha * (255 - alpha) / 255, so every lane can go through the same multiply-add
+
+// x / 255 for any x in [0, 255 * 255]
+static __m128i divide_by_255_sse2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+static __m128i blend_widened_sse2(__m128i src, __m128i dst)
+{
+    const auto max = _mm_set1_epi16(255);
+    const auto alpha_lanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    // broadcast the alpha of every pixel to all of its lanes
+    auto alpha = _mm_srli_epi64(src, 48);
+    alpha = _mm_or_si128(alpha, _mm_slli_epi64(alpha, 16));
+    alpha = _mm_or_si128(alpha, _mm_slli_epi64(alpha, 32));
+
+    auto src_factor = _mm_or_si128(_mm_andnot_si128(alpha_lanes, alpha), _mm_and_si128(alpha_lanes, max));
+    auto dst_factor = _mm_sub_epi16(max, alpha);
+
+    auto sum = _mm_add_epi16(_mm_mullo_epi16(src, src_factor), _mm_mullo_epi16(dst, dst_factor));
+    return divide_by_255_sse2(sum);
+}
+
+static void blend_pixels_sse2(u8* destination, const u8* source, usize pixel_count)
+{
+    const auto zero = _mm_setzero_si128();
+
+    usize i = 0;
+
+    for (; i + 4 <= pixel_count; i += 4)
+    {
+        auto src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * bytes_per_pixel));
+        auto dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * bytes_per_pixel));
+
+        auto low = blend_widened_sse2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+        auto high = blend_widened_sse2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * bytes_per_pixel), _mm_packus_epi16(low, high));
+    }
+
+    blend_pixels_scalar(destination + i * bytes_per_pixel, source + i * bytes_per_pixel, pixel_count - i);
+}
+
+static void blend_color_sse2(u8* pixels, usize pixel_count, u32 packed_color)
+{
+    const auto zero = _mm_setzero_si128();
+
+    // every pixel of the source is the same, so its widened halves are as well
+    const auto src = _mm_unpacklo_epi8(_mm_set1_epi32(std::bit_cast<i32>(packed_color)), zero);
+
+    usize i = 0;
+
+    for (; i + 4 <= pixel_count; i += 4)
+    {
+        auto dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * bytes_per_pixel));
+
+        auto low = blend_widened_sse2(src, _mm_unpacklo_epi8(dst, zero));
+        auto high = blend_widened_sse2(src, _mm_unpackhi_epi8(dst, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * bytes_per_pixel), _mm_packus_epi16(low, high));
+    }
+
+    blend_color_scalar(pixels + i * bytes_per_pixel, pixel_count - i, packed_color);
+}
+
+ZTH_TARGET_AVX2 static void fill_pixels_avx2(u8* pixels, usize pixel_count, u32 packed_color)
+{
+    const auto color = _mm256_set1_epi32(std::bit_cast<i32>(packed_color));
+
+    usize i = 0;
+
+    for (; i + 8 <= pixel_count; i += 8)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * bytes_per_pixel), color);
+
+    fill_pixels_scalar(pixels + i * bytes_per_pixel, pixel_count - i, packed_color);
+}
+
+ZTH_TARGET_AVX2 static __m256i divide_by_255_avx2(__m256i x)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)),
+                             8);
+}
+
+ZTH_TARGET_AVX2 static __m256i blend_widened_avx2(__m256i src, __m256i dst)
+{
+    const auto max = _mm256_set1_epi16(255);
+    const auto alpha_lanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+
+    auto alpha = _mm256_srli_epi64(src, 48);
+    alpha = _mm256_or_si256(alpha, _mm256_slli_epi64(alpha, 16));
+    alpha = _mm256_or_si256(alpha, _mm256_slli_epi64(alpha, 32));
+
+    auto src_factor = _mm256_or_si256(_mm256_andnot_si256(alpha_lanes, alpha), _mm256_and_si256(alpha_lanes, max));
+    auto dst_factor = _mm256_sub_epi16(max, alpha);
+
+    auto sum = _mm256_add_epi16(_mm256_mullo_epi16(src, src_factor), _mm256_mullo_epi16(dst, dst_factor));
+    return divide_by_255_avx2(sum);
+}
+
+ZTH_TARGET_AVX2 static void blend_pixels_avx2(u8* destination, const u8* source, usize pixel_count)
+{
+    const auto zero = _mm256_setzero_si256();
+
+    usize i = 0;
+
+    // unpacking and packing both work within 128-bit halves, so the pixels come out in their original order
+    for (; i + 8 <= pixel_count; i += 8)
+    {
+        auto src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * bytes_per_pixel));
+        auto dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i * bytes_per_pixel));
+
+        auto low = blend_widened_avx2(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero));
+        auto high = blend_widened_avx2(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * bytes_per_pixel),
+                            _mm256_packus_epi16(low, high));
+    }
+
+    blend_pixels_sse2(destination + i * bytes_per_pixel, source + i * bytes_per_pixel, pixel_count - i);
+}
+
+ZTH_TARGET_AVX2 static void blend_color_avx2(u8* pixels, usize pixel_count, u32 packed_color)
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto src = _mm256_unpacklo_epi8(_mm256_set1_epi32(std::bit_cast<i32>(packed_color)), zero);
+
+    usize i = 0;
+
+    for (; i + 8 <= pixel_count; i += 8)
+    {
+        auto dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * bytes_per_pixel));
+
+        auto low = blend_widened_avx2(src, _mm256_unpacklo_epi8(dst, zero));
+        auto high = blend_widened_avx2(src, _mm256_unpackhi_epi8(dst, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * bytes_per_pixel), _mm256_packus_epi16(low, high));
+    }
+
+    blend_color_sse2(pixels + i * bytes_per_pixel, pixel_count - i, packed_color);
+}
+
+static bool cpu_supports_avx2()
+{
+#if defined(_MSC_VER)
+    std::array<int, 4> registers{};
+
+    __cpuid(registers.data(), 0);
+
+    if (registers[0] < 7)
+        return false;
+
+    // the os has to save the ymm registers on context switches too
+    __cpuid(registers.data(), 1);
+
+    const bool os_uses_xsave = (registers[2] & (1 << 27)) != 0;
+    const bool cpu_supports_avx = (registers[2] & (1 << 28)) != 0;
+
+    if (!os_uses_xsave || !cpu_supports_avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(registers.data(), 7, 0);
+    return (registers[1] & (1 << 5)) != 0;
+#else
+    // queries cpuid and checks that the os saves the ymm registers
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+static PixelKernels select_pixel_kernels()
+{
+#if defined(ZTH_X86_64)
+    if (cpu_supports_avx2())
+        return { PixelKernelSet::Avx2, fill_pixels_avx2, blend_pixels_avx2, blend_color_avx2 };
+
+    return { PixelKernelSet::Sse2, fill_pixels_sse2, blend_pixels_sse2, blend_color_sse2 };
+#else
+    return { PixelKernelSet::Scalar, fill_pixels_scalar, blend_pixels_scalar, blend_color_scalar };
+#endif
+}
+
+static const PixelKernels& get_pixel_kernels()
+{
+    static const PixelKernels pixel_kernels = select_pixel_kernels();
+    return pixel_kernels;
+}
+
+void fill_pixels(u8* pixels, usize pixel_count, const Color& color)
+{
+    get_pixel_kernels().fill(pixels, pixel_count, pack_color(color));
+}
+
+void copy_pixels(u8* destination, const u8* source, usize pixel_count)
+{
+    // memcpy already is as fast as a copy can get on every platform
+    std::memcpy(destination, source, pixel_count * bytes_per_pixel);
+}
+
+void blend_pixels(u8* destination, const u8* source, usize pixel_count)
+{
+    get_pixel_kernels().blend(destination, source, pixel_count);
+}
+
+void blend_color(u8* pixels, usize pixel_count, const Color& color)
+{
+    get_pixel_kernels().blend_color(pixels, pixel_count, pack_color(color));
+}
+
+PixelKernelSet get_pixel_kernel_set()
+{
+    return get_pixel_kernels().set;
+}
+
+const char* to_string(PixelKernelSet pixel_kernel_set)
+{
+    switch (pixel_kernel_set)
+    {
+        using enum PixelKernelSet;
+    case Scalar:
+        return "Scalar";
+    case Sse2:
+        return "SSE2";
+    case Avx2:
+        return "AVX2";
+    }
+
+    assert(false);
+    return "Unknown";
+}
+
+} // namespace zth
@@ -143,4 +143,17 @@ void PrimitiveRenderer::draw_filled_ellipse(const Ellipse& ellipse, const Color&
     draw_filled_ellipse_impl(ellipse, color);
 }
 
+void PrimitiveRenderer::flush()
+{
+    flush_impl();
+}
+
+void PrimitiveRenderer::set_render_target(sf::RenderTarget& render_target)
+{
+    assert(_render_target);
+
+    flush();
+    _render_target = &render_target;
+}
+
 } // namespace zth
@@ -0,0 +1,462 @@
+#include "Zenith/Graphics/Rasterizer.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/PixelKernels.hpp"
+
+namespace zth {
+
+// sf::Image only hands out const access to its pixels, even though it owns them and they're never const
+static u8* get_pixels(sf::Image& image)
+{
+    return const_cast<u8*>(image.getPixelsPtr());
+}
+
+std::optional<PixelLine> clip_line(const Vec2f& from, const Vec2f& to, const Vec2u& size)
+{
+    if (size.x == 0 || size.y == 0)
+        return {};
+
+    const auto max = static_cast<Vec2f>(size);
+    const auto delta = to - from;
+
+    float t_enter = 0.0f;
+    float t_exit = 1.0f;
+
+    // each edge of the area is described as p * t <= q
+    const std::array<std::pair<float, float>, 4> edges = {
+        std::pair{ -delta.x, from.x },
+        std::pair{ delta.x, max.x - from.x },
+        std::pair{ -delta.y, from.y },
+        std::pair{ delta.y, max.y - from.y },
+    };
+
+    for (const auto& [p, q] : edges)
+    {
+        if (p == 0.0f)
+        {
+            // the line is parallel to the edge
+            if (q < 0.0f)
+                return {};
+
+            continue;
+        }
+
+        float t = q / p;
+
+        if (p < 0.0f)
+            t_enter = std::max(t_enter, t);
+        else
+            t_exit = std::min(t_exit, t);
+
+        if (t_enter > t_exit)
+            return {};
+    }
+
+    auto to_clipped_pixel = [&](float t) {
+        auto point = from + delta * t;
+
+        // a point lying exactly on the far edge belongs to the last pixel
+        return Vec2i{ std::clamp(static_cast<i32>(std::floor(point.x)), 0, static_cast<i32>(size.x) - 1),
+                      std::clamp(static_cast<i32>(std::floor(point.y)), 0, static_cast<i32>(size.y) - 1) };
+    };
+
+    return PixelLine{ to_clipped_pixel(t_enter), to_clipped_pixel(t_exit) };
+}
+
+std::optional<IntRect> get_raster_bounds(const Rect& bounds, const Vec2u& size)
+{
+    auto [x1, y1] = bounds.position;
+    auto [x2, y2] = bounds.position + bounds.size;
+
+    // shapes cover every pixel their edges pass through, including the pixel at the far edge
+    auto left = std::max(static_cast<i32>(std::floor(std::min(x1, x2))), 0);
+    auto top = std::max(static_cast<i32>(std::floor(std::min(y1, y2))), 0);
+    auto right = std::min(static_cast<i32>(std::floor(std::max(x1, x2))) + 1, static_cast<i32>(size.x));
+    auto bottom = std::min(static_cast<i32>(std::floor(std::max(y1, y2))) + 1, static_cast<i32>(size.y));
+
+    if (left >= right || top >= bottom)
+        return {};
+
+    return IntRect{ .position = { left, top }, .size = { right - left, bottom - top } };
+}
+
+static bool pixel_has_color(const u8* pixel, const Color& color)
+{
+    const std::array channels = { color.r, color.g, color.b, color.a };
+    return std::memcmp(pixel, channels.data(), bytes_per_pixel) == 0;
+}
+
+Vec2i to_pixel(const Vec2f& point)
+{
+    return { static_cast<i32>(std::floor(point.x)), static_cast<i32>(std::floor(point.y)) };
+}
+
+i32 to_pixel_radius(float radius)
+{
+    return static_cast<i32>(std::round(radius));
+}
+
+void blend_image(sf::Image& destination, const sf::Image& source, const Vec2i& position)
+{
+    const auto destination_size = destination.getSize();
+    const auto source_size = source.getSize();
+
+    if (source_size.x == 0 || source_size.y == 0)
+        return;
+
+    assert(position.x >= 0 && position.y >= 0);
+    assert(static_cast<u32>(position.x) + source_size.x <= destination_size.x);
+    assert(static_cast<u32>(position.y) + source_size.y <= destination_size.y);
+
+    auto destination_pixels = get_pixels(destination);
+    auto source_pixels = source.getPixelsPtr();
+
+    for (u32 y = 0; y < source_size.y; y++)
+    {
+        auto destination_row = (static_cast<usize>(static_cast<u32>(position.y) + y) * destination_size.x
+                                + static_cast<u32>(position.x))
+                               * bytes_per_pixel;
+        auto source_row = static_cast<usize>(y) * source_size.x * bytes_per_pixel;
+
+        blend_pixels(destination_pixels + destination_row, source_pixels + source_row, source_size.x);
+    }
+}
+
+ImageRasterizer::ImageRasterizer(sf::Image& image)
+    : _image(image), _clip_rect{ .position = { 0, 0 }, .size = static_cast<Vec2i>(Vec2u{ image.getSize() }) }
+{
+    if (_clip_rect.size.x > 0 && _clip_rect.size.y > 0)
+        _pixels = get_pixels(image);
+}
+
+ImageRasterizer::ImageRasterizer(sf::Image& image, const IntRect& clip_rect) : ImageRasterizer(image)
+{
+    auto left = std::max(clip_rect.position.x, 0);
+    auto top = std::max(clip_rect.position.y, 0);
+    auto right = std::min(clip_rect.position.x + clip_rect.size.x, _clip_rect.size.x);
+    auto bottom = std::min(clip_rect.position.y + clip_rect.size.y, _clip_rect.size.y);
+
+    _clip_rect = { .position = { left, top }, .size = { std::max(right - left, 0), std::max(bottom - top, 0) } };
+}
+
+void ImageRasterizer::set_pixel(i32 x, i32 y, const sf::Color& color)
+{
+    // pixels outside of the clip rect are skipped, so that shapes can be partially out of it
+    if (x < _clip_rect.position.x || y < _clip_rect.position.y || x >= _clip_rect.position.x + _clip_rect.size.x
+        || y >= _clip_rect.position.y + _clip_rect.size.y)
+        return;
+
+    if (blend && color.a != 255)
+    {
+        const auto image_width = static_cast<usize>(_image.getSize().x);
+        auto pixel = _pixels + (static_cast<usize>(y) * image_width + static_cast<usize>(x)) * bytes_per_pixel;
+
+        blend_color(pixel, 1, { .r = color.r, .g = color.g, .b = color.b, .a = color.a });
+        return;
+    }
+
+    _image.setPixel(static_cast<u32>(x), static_cast<u32>(y), color);
+}
+
+void ImageRasterizer::clear(const Color& color)
+{
+    for (auto y = _clip_rect.position.y; y < _clip_rect.position.y + _clip_rect.size.y; y++)
+        fill_span(y, _clip_rect.position.x, _clip_rect.position.x + _clip_rect.size.x - 1, color);
+}
+
+void ImageRasterizer::draw_point(const Vec2f& point, const Color& color)
+{
+    auto [x, y] = to_pixel(point);
+    set_pixel(x, y, static_cast<sf::Color>(color));
+}
+
+void ImageRasterizer::draw_line(const Vec2f& from, const Vec2f& to, const Color& color)
+{
+    // the line gets clipped to the whole image rather than the clip rect, so that it always passes through the same
+    // pixels no matter which part of the image is being drawn
+    auto line = clip_line(from, to, Vec2u{ _image.getSize() });
+
+    if (!line)
+        return;
+
+    const auto sf_color = static_cast<sf::Color>(color);
+    bresenham_line(*line, [&](i32 x, i32 y) { set_pixel(x, y, sf_color); });
+}
+
+void ImageRasterizer::draw_line(const Line& line, const Color& color)
+{
+    draw_line(line.from, line.to, color);
+}
+
+void ImageRasterizer::draw_line_strip(std::span<const Vec2f> points, const Color& color)
+{
+    for (const auto line : points | std::views::adjacent<2>)
+    {
+        const auto& [from, to] = line;
+        draw_line(from, to, color);
+    }
+}
+
+void ImageRasterizer::draw_lines(std::span<const Line> lines, const Color& color)
+{
+    for (const auto& line : lines)
+        draw_line(line, color);
+}
+
+void ImageRasterizer::draw_triangle(const Triangle& triangle, const Color& color)
+{
+    draw_line_strip(triangle.points, color);
+    draw_line(triangle.points.back(), triangle.points.front(), color);
+}
+
+void ImageRasterizer::draw_rect(const Rect& rect, const Color& color)
+{
+    auto points = rect.points();
+    draw_line_strip(points, color);
+    draw_line(points.back(), points.front(), color);
+}
+
+void ImageRasterizer::draw_circle(const Circle& circle, const Color& color)
+{
+    const auto sf_color = static_cast<sf::Color>(color);
+
+    midpoint_circle(to_pixel(circle.center), to_pixel_radius(circle.radius),
+                    [&](i32 x, i32 y) { set_pixel(x, y, sf_color); });
+}
+
+void ImageRasterizer::draw_ellipse(const Ellipse& ellipse, const Color& color)
+{
+    if (ellipse.radius.x == ellipse.radius.y)
+    {
+        draw_circle(Circle{ ellipse.center, ellipse.radius.x }, color);
+        return;
+    }
+
+    const auto sf_color = static_cast<sf::Color>(color);
+
+    midpoint_ellipse(to_pixel(ellipse.center),
+                     { to_pixel_radius(ellipse.radius.x), to_pixel_radius(ellipse.radius.y) },
+                     [&](i32 x, i32 y) { set_pixel(x, y, sf_color); });
+}
+
+void ImageRasterizer::fill_span(i32 y, i32 x_start, i32 x_end, const Color& color)
+{
+    if (y < _clip_rect.position.y || y >= _clip_rect.position.y + _clip_rect.size.y)
+        return;
+
+    x_start = std::max(x_start, _clip_rect.position.x);
+    x_end = std::min(x_end, _clip_rect.position.x + _clip_rect.size.x - 1);
+
+    if (x_start > x_end)
+        return;
+
+    const auto image_width = static_cast<usize>(_image.getSize().x);
+    auto row = _pixels + (static_cast<usize>(y) * image_width + static_cast<usize>(x_start)) * bytes_per_pixel;
+
+    const auto pixel_count = static_cast<usize>(x_end - x_start + 1);
+
+    if (blend && color.a != 255)
+        blend_color(row, pixel_count, color);
+    else
+        fill_pixels(row, pixel_count, color);
+}
+
+void ImageRasterizer::fill_rect(const Rect& rect, const Color& color)
+{
+    auto [x1, y1] = rect.position;
+    auto [x2, y2] = rect.position + rect.size;
+
+    auto x_start = static_cast<i32>(std::floor(std::min(x1, x2)));
+    auto x_end = static_cast<i32>(std::floor(std::max(x1, x2)));
+    auto y_start = std::max(static_cast<i32>(std::floor(std::min(y1, y2))), _clip_rect.position.y);
+    auto y_end = std::min(static_cast<i32>(std::floor(std::max(y1, y2))),
+                          _clip_rect.position.y + _clip_rect.size.y - 1);
+
+    for (auto y = y_start; y <= y_end; y++)
+        fill_span(y, x_start, x_end, color);
+}
+
+// widens the span so that it covers the point where the edge crosses the row at the given height
+static void extend_span(const Vec2f& from, const Vec2f& to, float y, float& span_start, float& span_end)
+{
+    auto [min_y, max_y] = std::minmax(from.y, to.y);
+
+    if (y < min_y || y > max_y)
+        return;
+
+    if (from.y == to.y)
+    {
+        // horizontal edge lying on the row covers the whole edge
+        span_start = std::min({ span_start, from.x, to.x });
+        span_end = std::max({ span_end, from.x, to.x });
+        return;
+    }
+
+    float x = from.x + (y - from.y) * (to.x - from.x) / (to.y - from.y);
+    span_start = std::min(span_start, x);
+    span_end = std::max(span_end, x);
+}
+
+template<typename GetPointFn>
+void ImageRasterizer::fill_convex_polygon(usize point_count, GetPointFn&& get_point, const Color& color)
+{
+    if (point_count == 0)
+        return;
+
+    float min_y = std::numeric_limits<float>::max();
+    float max_y = std::numeric_limits<float>::lowest();
+
+    for (usize i = 0; i < point_count; i++)
+    {
+        min_y = std::min(min_y, get_point(i).y);
+        max_y = std::max(max_y, get_point(i).y);
+    }
+
+    auto y_start = std::max(static_cast<i32>(std::floor(min_y)), _clip_rect.position.y);
+    auto y_end = std::min(static_cast<i32>(std::floor(max_y)), _clip_rect.position.y + _clip_rect.size.y - 1);
+
+    // the polygon is convex, so every row crosses it in exactly one span
+    for (auto y = y_start; y <= y_end; y++)
+    {
+        // sample the row at the pixel center, but keep the sample inside the polygon so that thin polygons still
+        // produce a span
+        float sample_y = std::clamp(static_cast<float>(y) + 0.5f, min_y, max_y);
+
+        float span_start = std::numeric_limits<float>::max();
+        float span_end = std::numeric_limits<float>::lowest();
+
+        for (usize i = 0; i < point_count; i++)
+            extend_span(get_point(i), get_point((i + 1) % point_count), sample_y, span_start, span_end);
+
+        if (span_start > span_end)
+            continue;
+
+        fill_span(y, static_cast<i32>(std::floor(span_start)), static_cast<i32>(std::floor(span_end)), color);
+    }
+}
+
+void ImageRasterizer::fill_convex_polygon(std::span<const Vec2f> points, const Color& color)
+{
+    fill_convex_polygon(points.size(), [&](usize i) -> const Vec2f& { return points[i]; }, color);
+}
+
+void ImageRasterizer::fill_convex_polygon(std::span<const Line> lines, const Color& color)
+{
+    // the lines are connected, so the polygon is made up of their starting points
+    fill_convex_polygon(lines.size(), [&](usize i) -> const Vec2f& { return lines[i].from; }, color);
+}
+
+void ImageRasterizer::fill_circle(const Circle& circle, const Color& color)
+{
+    fill_ellipse(Ellipse{ circle.center, { circle.radius, circle.radius } }, color);
+}
+
+void ImageRasterizer::fill_ellipse(const Ellipse& ellipse, const Color& color)
+{
+    auto [xc, yc] = ellipse.center;
+    auto [rx, ry] = ellipse.radius;
+
+    if (rx < 0.0f || ry <= 0.0f)
+        return;
+
+    auto y_start = std::max(static_cast<i32>(std::floor(yc - ry)), _clip_rect.position.y);
+    auto y_end = std::min(static_cast<i32>(std::floor(yc + ry)), _clip_rect.position.y + _clip_rect.size.y - 1);
+
+    for (auto y = y_start; y <= y_end; y++)
+    {
+        float dy = std::clamp(static_cast<float>(y) + 0.5f - yc, -ry, ry) / ry;
+        float half_width = rx * std::sqrt(std::max(1.0f - dy * dy, 0.0f));
+
+        fill_span(y, static_cast<i32>(std::floor(xc - half_width)), static_cast<i32>(std::floor(xc + half_width)),
+                  color);
+    }
+}
+
+template<typename IsFillableFn>
+void ImageRasterizer::seed_fill(const Vec2i& seed, IsFillableFn&& is_fillable, const Color& fill_color,
+                                std::vector<Vec2i>& stack)
+{
+    const auto left = _clip_rect.position.x;
+    const auto top = _clip_rect.position.y;
+    const auto right = left + _clip_rect.size.x - 1;
+    const auto bottom = top + _clip_rect.size.y - 1;
+
+    if (seed.x < left || seed.y < top || seed.x > right || seed.y > bottom)
+        return;
+
+    auto fillable = [&](i32 x, i32 y) { return is_fillable(get_pixel(x, y)); };
+
+    stack.clear();
+    stack.push_back(seed);
+
+    while (!stack.empty())
+    {
+        auto [x, y] = stack.back();
+        stack.pop_back();
+
+        // the pixel could have been filled already as a part of another span
+        if (!fillable(x, y))
+            continue;
+
+        auto span_start = x;
+        auto span_end = x;
+
+        while (span_start > left && fillable(span_start - 1, y))
+            span_start--;
+
+        while (span_end < right && fillable(span_end + 1, y))
+            span_end++;
+
+        fill_span(y, span_start, span_end, fill_color);
+
+        // every run of fillable pixels touching the span from above or below gets a single seed
+        for (auto neighbour_y : { y - 1, y + 1 })
+        {
+            if (neighbour_y < top || neighbour_y > bottom)
+                continue;
+
+            bool in_run = false;
+
+            for (auto neighbour_x = span_start; neighbour_x <= span_end; neighbour_x++)
+            {
+                bool neighbour_fillable = fillable(neighbour_x, neighbour_y);
+
+                if (neighbour_fillable && !in_run)
+                    stack.emplace_back(neighbour_x, neighbour_y);
+
+                in_run = neighbour_fillable;
+            }
+        }
+    }
+}
+
+void ImageRasterizer::boundary_fill(const Vec2i& seed, const Color& border_color, const Color& fill_color,
+                                    std::vector<Vec2i>& stack)
+{
+    auto is_fillable = [&](const u8* pixel) {
+        return !pixel_has_color(pixel, border_color) && !pixel_has_color(pixel, fill_color);
+    };
+
+    seed_fill(seed, is_fillable, fill_color, stack);
+}
+
+void ImageRasterizer::flood_fill(const Vec2i& seed, const Color& fill_color, const Color& background_color,
+                                 std::vector<Vec2i>& stack)
+{
+    auto is_fillable = [&](const u8* pixel) {
+        return pixel_has_color(pixel, background_color) && !pixel_has_color(pixel, fill_color);
+    };
+
+    seed_fill(seed, is_fillable, fill_color, stack);
+}
+
+const u8* ImageRasterizer::get_pixel(i32 x, i32 y) const
+{
+    const auto image_width = static_cast<usize>(_image.getSize().x);
+    return _pixels + (static_cast<usize>(y) * image_width + static_cast<usize>(x)) * bytes_per_pixel;
+}
+
+} // namespace zth
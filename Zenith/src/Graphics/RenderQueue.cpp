@@ -0,0 +1,113 @@
+#include "Zenith/Graphics/RenderQueue.hpp"
+
+#include "Zenith/Graphics/Renderer.hpp"
+
+namespace zth {
+
+static u16 get_id(std::unordered_map<const void*, u16>& ids, const void* object)
+{
+    if (!object)
+        return 0;
+
+    // past the last id objects stop being told apart, which only costs some extra state changes
+    const auto next_id = static_cast<u16>(std::min(ids.size() + 1, usize{ std::numeric_limits<u16>::max() }));
+
+    return ids.try_emplace(object, next_id).first->second;
+}
+
+void RenderQueue::submit(const Drawable& drawable, const RenderKey& key)
+{
+    _commands.push_back({ .sort_key = make_sort_key(key), .drawable = &drawable });
+}
+
+void RenderQueue::execute(Renderer& renderer)
+{
+    sort();
+
+    for (const auto& command : _commands)
+        renderer.draw(*command.drawable);
+
+    clear();
+}
+
+void RenderQueue::clear()
+{
+    _commands.clear();
+    _shader_ids.clear();
+    _texture_ids.clear();
+}
+
+void RenderQueue::set_layer_grouped(u16 layer, bool is_grouped)
+{
+    if (is_grouped == is_layer_grouped(layer))
+        return;
+
+    if (is_grouped)
+        _grouped_layers.push_back(layer);
+    else
+        std::erase(_grouped_layers, layer);
+}
+
+bool RenderQueue::is_layer_grouped(u16 layer) const
+{
+    return std::ranges::find(_grouped_layers, layer) != _grouped_layers.end();
+}
+
+u64 RenderQueue::make_sort_key(const RenderKey& key)
+{
+    // | layer: 16 | shader: 16 | texture: 16 | depth: 16 |
+    auto sort_key = static_cast<u64>(key.layer) << 48 | static_cast<u64>(key.depth);
+
+    if (is_layer_grouped(key.layer))
+    {
+        sort_key |= static_cast<u64>(get_id(_shader_ids, key.shader)) << 32
+                    | static_cast<u64>(get_id(_texture_ids, key.texture)) << 16;
+    }
+
+    return sort_key;
+}
+
+void RenderQueue::sort()
+{
+    // least significant digit first radix sort, one byte at a time
+    // every pass is stable, which keeps the submission order of commands with equal keys
+    constexpr usize radix = 256;
+    constexpr usize pass_count = sizeof(u64);
+
+    const auto command_count = _commands.size();
+
+    if (command_count < 2)
+        return;
+
+    _sorted_commands.resize(command_count);
+
+    for (usize pass = 0; pass < pass_count; pass++)
+    {
+        const auto shift = pass * 8;
+
+        std::array<usize, radix> offsets{};
+
+        for (const auto& command : _commands)
+            offsets[command.sort_key >> shift & 0xff]++;
+
+        // every command has the same byte, so this pass wouldn't move anything
+        if (offsets[_commands.front().sort_key >> shift & 0xff] == command_count)
+            continue;
+
+        usize offset = 0;
+
+        for (auto& count : offsets)
+        {
+            const auto bucket_size = count;
+            count = offset;
+            offset += bucket_size;
+        }
+
+        for (const auto& command : _commands)
+            _sorted_commands[offsets[command.sort_key >> shift & 0xff]++] = command;
+
+        _commands.swap(_sorted_commands);
+    }
+}
+
+} // namespace zth
@@ -1,8 +1,10 @@
 #include "Zenith/Graphics/Renderer.hpp"
 
 #include "Zenith/Graphics/Drawable.hpp"
+#include "Zenith/Graphics/LayerCache.hpp"
 #include "Zenith/Graphics/Sprite.hpp"
 #include "Zenith/Graphics/VertexArray.hpp"
+#include "Zenith/Graphics/VertexBuffer.hpp"
 
 namespace zth {
 
@@ -11,18 +13,80 @@ void Renderer::draw(const Drawable& drawable)
     drawable.draw(*this);
 }
 
-void Renderer::draw_sprite(const Sprite& sprite) const
+void Renderer::draw_sprite(const Sprite& sprite)
 {
-    _render_target.draw(sprite._sprite);
+    // primitives batched up to this point have to end up below the sprite
+    begin_batch(BatchType::Sprites);
+    _sprite_batch.add(sprite._sprite);
 }
 
-void Renderer::draw_vertex_array(const VertexArray& vertex_array) const
+void Renderer::draw_vertex_array(const VertexArray& vertex_array)
 {
-    _render_target.draw(vertex_array._vertex_array);
+    flush_batches();
+    vertex_array.draw_to(*_render_target);
+}
+
+void Renderer::draw_vertex_buffer(const VertexBuffer& vertex_buffer)
+{
+    flush_batches();
+    _render_target->draw(vertex_buffer._vertex_buffer);
+}
+
+void Renderer::draw_layer_cache(const LayerCache& layer_cache)
+{
+    flush_batches();
+    layer_cache.draw_to(*_render_target);
+}
+
+void Renderer::flush()
+{
+    flush_batches();
+    // whatever was drawn through a renderer which was gotten before the last batch switch still gets drawn
+    _instanced_renderer.flush();
+    _selected_primitive_renderer->flush();
+}
+
+Rect Renderer::view_bounds() const
+{
+    const auto& view = _render_target->getView();
+    const auto& inverse_transform = view.getInverseTransform();
+
+    // the view can be rotated, so the bounds have to enclose all of its corners
+    const std::array corners = {
+        inverse_transform.transformPoint(-1.0f, -1.0f),
+        inverse_transform.transformPoint(1.0f, -1.0f),
+        inverse_transform.transformPoint(1.0f, 1.0f),
+        inverse_transform.transformPoint(-1.0f, 1.0f),
+    };
+
+    auto min = corners[0];
+    auto max = corners[0];
+
+    for (const auto& corner : corners)
+    {
+        min = { std::min(min.x, corner.x), std::min(min.y, corner.y) };
+        max = { std::max(max.x, corner.x), std::max(max.y, corner.y) };
+    }
+
+    return { .position = { min.x, min.y }, .size = { max.x - min.x, max.y - min.y } };
+}
+
+void Renderer::set_render_target(sf::RenderTarget& render_target)
+{
+    flush();
+
+    _render_target = &render_target;
+    _instanced_renderer.set_render_target(render_target);
+    _sfml_primitive_renderer.set_render_target(render_target);
+    _custom_primitive_renderer.set_render_target(render_target);
+    _tiled_primitive_renderer.set_render_target(render_target);
 }
 
 void Renderer::set_primitive_renderer_type(PrimitiveRendererType primitive_renderer_type)
 {
+    // primitives batched so far have to be drawn by the renderer which they were given to
+    flush_batches();
+
     switch (primitive_renderer_type)
     {
     case PrimitiveRendererType::SfmlPrimitiveRenderer:
@@ -31,6 +95,9 @@ void Renderer::set_primitive_renderer_type(PrimitiveRendererType primitive_rende
     case PrimitiveRendererType::CustomPrimitiveRenderer:
         _selected_primitive_renderer = &_custom_primitive_renderer;
         break;
+    case PrimitiveRendererType::TiledPrimitiveRenderer:
+        _selected_primitive_renderer = &_tiled_primitive_renderer;
+        break;
     }
 }
 
@@ -40,9 +107,40 @@ PrimitiveRendererType Renderer::get_primitive_renderer_type() const
         return PrimitiveRendererType::SfmlPrimitiveRenderer;
     else if (_selected_primitive_renderer == &_custom_primitive_renderer)
         return PrimitiveRendererType::CustomPrimitiveRenderer;
+    else if (_selected_primitive_renderer == &_tiled_primitive_renderer)
+        return PrimitiveRendererType::TiledPrimitiveRenderer;
 
     assert(false);
     std::unreachable();
 }
 
+void Renderer::begin_batch(BatchType batch_type)
+{
+    if (batch_type == _batch_type)
+        return;
+
+    flush_batches();
+    _batch_type = batch_type;
+}
+
+void Renderer::flush_batches()
+{
+    switch (_batch_type)
+    {
+    case BatchType::None:
+        break;
+    case BatchType::Sprites:
+        _sprite_batch.draw(*_render_target);
+        break;
+    case BatchType::Instances:
+        _instanced_renderer.flush();
+        break;
+    case BatchType::Primitives:
+        _selected_primitive_renderer->flush();
+        break;
+    }
+
+    _batch_type = BatchType::None;
+}
+
 } // namespace zth
@@ -1,5 +1,7 @@
 #include "Zenith/Graphics/SfmlEllipseShape.hpp"
 
+#include "Zenith/Graphics/UnitCircleCache.hpp"
+
 namespace zth {
 
 SfmlEllipseShape::SfmlEllipseShape(const sf::Vector2f& radius) : _radius(radius)
@@ -34,7 +36,8 @@ sf::Vector2f SfmlEllipseShape::getPoint(std::size_t index) const
 
 void SfmlEllipseShape::update_point_count()
 {
-    _point_count = static_cast<std::size_t>(std::ceil(std::max(_radius.x, _radius.y)));
+    auto level = UnitCircleCache::get_level(std::max(_radius.x, _radius.y));
+    _point_count = UnitCircleCache::get_point_count(level);
 }
 
 } // namespace zth
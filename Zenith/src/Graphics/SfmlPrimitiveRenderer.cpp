@@ -1,9 +1,5 @@
 #include "Zenith/Graphics/SfmlPrimitiveRenderer.hpp"
 
-#include <SFML/Graphics/CircleShape.hpp>
-
-#include "Zenith/Graphics/SfmlEllipseShape.hpp"
-
 namespace zth {
 
 void SfmlPrimitiveRenderer::draw_point_impl(const Vec2f& point, const Color& color)
@@ -104,46 +100,26 @@ void SfmlPrimitiveRenderer::draw_filled_convex_polygon_impl(std::span<const Line
 
 void SfmlPrimitiveRenderer::draw_circle_impl(const Circle& circle, const Color& color)
 {
-    sf::CircleShape sf_circle;
-    sf_circle.setRadius(circle.radius);
-    sf_circle.setOutlineColor(static_cast<sf::Color>(color));
-    sf_circle.setOutlineThickness(1);
-    sf_circle.setFillColor(static_cast<sf::Color>(Color::transparent));
-    sf_circle.setPosition(static_cast<sf::Vector2f>(circle.center - Vec2f{ circle.radius, circle.radius }));
-
-    _render_target.draw(sf_circle);
+    plot_ellipse(Ellipse{ circle.center, { circle.radius, circle.radius } }, color);
+    draw_call(PrimitiveType::LineStrip);
 }
 
 void SfmlPrimitiveRenderer::draw_ellipse_impl(const Ellipse& ellipse, const Color& color)
 {
-    SfmlEllipseShape sf_ellipse(ellipse);
-    sf_ellipse.setOutlineColor(static_cast<sf::Color>(color));
-    sf_ellipse.setOutlineThickness(1);
-    sf_ellipse.setFillColor(static_cast<sf::Color>(Color::transparent));
-
-    _render_target.draw(sf_ellipse);
+    plot_ellipse(ellipse, color);
+    draw_call(PrimitiveType::LineStrip);
 }
 
 void SfmlPrimitiveRenderer::draw_filled_circle_impl(const Circle& circle, const Color& color)
 {
-    sf::CircleShape sf_circle;
-    sf_circle.setRadius(circle.radius);
-    sf_circle.setOutlineColor(static_cast<sf::Color>(color));
-    sf_circle.setOutlineThickness(1);
-    sf_circle.setFillColor(static_cast<sf::Color>(color));
-    sf_circle.setPosition(static_cast<sf::Vector2f>(circle.center - Vec2f{ circle.radius, circle.radius }));
-
-    _render_target.draw(sf_circle);
+    plot_filled_ellipse(Ellipse{ circle.center, { circle.radius, circle.radius } }, color);
+    draw_call(PrimitiveType::TriangleFan);
 }
 
 void SfmlPrimitiveRenderer::draw_filled_ellipse_impl(const Ellipse& ellipse, const Color& color)
 {
-    SfmlEllipseShape sf_ellipse(ellipse);
-    sf_ellipse.setOutlineColor(static_cast<sf::Color>(color));
-    sf_ellipse.setOutlineThickness(1);
-    sf_ellipse.setFillColor(static_cast<sf::Color>(color));
-
-    _render_target.draw(sf_ellipse);
+    plot_filled_ellipse(ellipse, color);
+    draw_call(PrimitiveType::TriangleFan);
 }
 
 void SfmlPrimitiveRenderer::plot_point(const Vec2f& point, const Color& color)
@@ -257,11 +233,138 @@ void SfmlPrimitiveRenderer::plot_filled_convex_polygon(std::span<const Line> lin
     plot_point(lines.back().to, color);
 }
 
+void SfmlPrimitiveRenderer::plot_ellipse(const Ellipse& ellipse, const Color& color)
+{
+    // sfml shapes put their outline outside of the shape, so the line runs through the middle of where the outline
+    // would be
+    auto radius = ellipse.radius + Vec2f{ 0.5f, 0.5f };
+    auto ring = _unit_circle_cache.get_ring(std::max(radius.x, radius.y), circle_tolerance);
+
+    auto to_ellipse_point = [&](const Vec2f& point) {
+        return ellipse.center + Vec2f{ point.x * radius.x, point.y * radius.y };
+    };
+
+    for (const auto& point : ring)
+        plot_point(to_ellipse_point(point), color);
+
+    plot_point(to_ellipse_point(ring.front()), color);
+}
+
+void SfmlPrimitiveRenderer::plot_filled_ellipse(const Ellipse& ellipse, const Color& color)
+{
+    // covers the outline as well, the same as an sfml shape with an outline of the fill color
+    auto radius = ellipse.radius + Vec2f{ 1.0f, 1.0f };
+    auto ring = _unit_circle_cache.get_ring(std::max(radius.x, radius.y), circle_tolerance);
+
+    auto to_ellipse_point = [&](const Vec2f& point) {
+        return ellipse.center + Vec2f{ point.x * radius.x, point.y * radius.y };
+    };
+
+    plot_point(ellipse.center, color);
+
+    for (const auto& point : ring)
+        plot_point(to_ellipse_point(point), color);
+
+    plot_point(to_ellipse_point(ring.front()), color);
+}
+
+void SfmlPrimitiveRenderer::flush_impl()
+{
+    submit_batch();
+}
+
 void SfmlPrimitiveRenderer::draw_call(PrimitiveType primitive_type)
 {
+    if (batch_draw_calls)
+    {
+        add_to_batch(primitive_type);
+        _vertex_array.clear();
+        return;
+    }
+
+    // batching could have been turned off in the middle of a frame
+    submit_batch();
+
     _vertex_array.set_primitive_type(primitive_type);
-    _render_target.draw(_vertex_array._vertex_array);
+    _vertex_array.draw_to(*_render_target);
     _vertex_array.clear();
 }
 
+void SfmlPrimitiveRenderer::add_to_batch(PrimitiveType primitive_type)
+{
+    const auto list_primitive_type = to_list_primitive_type(primitive_type);
+
+    if (list_primitive_type != _batch_primitive_type)
+    {
+        submit_batch();
+        _batch_primitive_type = list_primitive_type;
+    }
+
+    const auto vertices = _vertex_array.vertices();
+    auto& batch = _batch_vertex_array;
+    const auto vertex_count = vertices.size();
+
+    switch (primitive_type)
+    {
+    case PrimitiveType::Points:
+    case PrimitiveType::Lines:
+    case PrimitiveType::Triangles:
+        batch.append(vertices);
+        break;
+    case PrimitiveType::LineStrip:
+        for (usize i = 1; i < vertex_count; i++)
+        {
+            batch.append(vertices[i - 1]);
+            batch.append(vertices[i]);
+        }
+        break;
+    case PrimitiveType::TriangleStrip:
+        for (usize i = 2; i < vertex_count; i++)
+        {
+            batch.append(vertices[i - 2]);
+            batch.append(vertices[i - 1]);
+            batch.append(vertices[i]);
+        }
+        break;
+    case PrimitiveType::TriangleFan:
+        for (usize i = 2; i < vertex_count; i++)
+        {
+            batch.append(vertices[0]);
+            batch.append(vertices[i - 1]);
+            batch.append(vertices[i]);
+        }
+        break;
+    }
+}
+
+void SfmlPrimitiveRenderer::submit_batch()
+{
+    if (_batch_vertex_array.vertex_count() == 0)
+        return;
+
+    _batch_vertex_array.set_primitive_type(_batch_primitive_type);
+    _batch_vertex_array.draw_to(*_render_target);
+    _batch_vertex_array.clear();
+}
+
+PrimitiveType SfmlPrimitiveRenderer::to_list_primitive_type(PrimitiveType primitive_type)
+{
+    switch (primitive_type)
+    {
+        using enum PrimitiveType;
+    case Points:
+        return Points;
+    case Lines:
+    case LineStrip:
+        return Lines;
+    case Triangles:
+    case TriangleStrip:
+    case TriangleFan:
+        return Triangles;
+    }
+
+    assert(false);
+    std::unreachable();
+}
+
 } // namespace zth
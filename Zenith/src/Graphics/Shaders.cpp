@@ -8,4 +8,12 @@ static const auto basic_shader_vert = b::embed<"src/Shaders/basic.vert">();
 static const auto basic_shader_frag = b::embed<"src/Shaders/basic.frag">();
 const Shader basic_shader{ basic_shader_vert, basic_shader_frag };
 
+static const auto instanced_shader_vert = b::embed<"src/Shaders/instanced.vert">();
+static const auto instanced_rect_shader_frag = b::embed<"src/Shaders/instanced_rect.frag">();
+static const auto instanced_circle_shader_frag = b::embed<"src/Shaders/instanced_circle.frag">();
+static const auto instanced_sprite_shader_frag = b::embed<"src/Shaders/instanced_sprite.frag">();
+Shader instanced_rect_shader{ instanced_shader_vert, instanced_rect_shader_frag };
+Shader instanced_circle_shader{ instanced_shader_vert, instanced_circle_shader_frag };
+Shader instanced_sprite_shader{ instanced_shader_vert, instanced_sprite_shader_frag };
+
 } // namespace zth::shaders
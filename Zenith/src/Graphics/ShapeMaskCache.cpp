@@ -0,0 +1,162 @@
+#include "Zenith/Graphics/ShapeMaskCache.hpp"
+
+#include <bit>
+
+#include "Zenith/Graphics/PixelKernels.hpp"
+
+namespace zth {
+
+ShapeMask create_shape_mask(const sf::Image& image)
+{
+    const auto image_size = image.getSize();
+
+    ShapeMask mask{ .size = static_cast<Vec2i>(Vec2u{ image_size }), .spans = {} };
+
+    if (image_size.x == 0 || image_size.y == 0)
+        return mask;
+
+    const auto pixels = image.getPixelsPtr();
+
+    auto is_covered = [&](u32 x, u32 y) {
+        return pixels[(static_cast<usize>(y) * image_size.x + x) * bytes_per_pixel + 3] != 0;
+    };
+
+    for (u32 y = 0; y < image_size.y; y++)
+    {
+        for (u32 x = 0; x < image_size.x; x++)
+        {
+            if (!is_covered(x, y))
+                continue;
+
+            auto span_start = x;
+
+            while (x + 1 < image_size.x && is_covered(x + 1, y))
+                x++;
+
+            mask.spans.push_back(
+                { .y = static_cast<i32>(y), .x_start = static_cast<i32>(span_start), .x_end = static_cast<i32>(x) });
+        }
+    }
+
+    return mask;
+}
+
+const ShapeMask* ShapeMaskCache::find(u32 kind, std::span<const float> key)
+{
+    const auto hash = hash_key(kind, key);
+    auto [first, last] = _lookup.equal_range(hash);
+
+    for (auto it = first; it != last; ++it)
+    {
+        auto entry = it->second;
+
+        if (entry->kind != kind || !std::ranges::equal(entry->key, key))
+            continue;
+
+        // move the entry to the front, as it's now the most recently used one
+        _entries.splice(_entries.begin(), _entries, entry);
+        _hits++;
+        return &entry->mask;
+    }
+
+    _misses++;
+    return nullptr;
+}
+
+void ShapeMaskCache::insert(u32 kind, std::span<const float> key, const ShapeMask& mask)
+{
+    const auto memory_usage =
+        sizeof(Entry) + key.size() * sizeof(float) + mask.spans.size() * sizeof(ShapeMaskSpan);
+
+    if (memory_usage > _memory_budget)
+        return;
+
+    const auto hash = hash_key(kind, key);
+
+    // a colliding hash only gets a mask cached a miss early, which is harmless
+    if (!_missed_keys.erase(hash))
+    {
+        if (_missed_keys.size() >= max_missed_key_count)
+            _missed_keys.clear();
+
+        _missed_keys.insert(hash);
+        return;
+    }
+
+    evict(_memory_budget - memory_usage);
+
+    _entries.push_front({
+        .hash = hash,
+        .kind = kind,
+        .key = { key.begin(), key.end() },
+        .mask = mask,
+        .memory_usage = memory_usage,
+    });
+
+    _lookup.emplace(hash, _entries.begin());
+    _memory_usage += memory_usage;
+}
+
+void ShapeMaskCache::clear()
+{
+    _entries.clear();
+    _lookup.clear();
+    _missed_keys.clear();
+    _memory_usage = 0;
+}
+
+void ShapeMaskCache::set_memory_budget(usize memory_budget)
+{
+    _memory_budget = memory_budget;
+    evict(memory_budget);
+}
+
+void ShapeMaskCache::reset_counters()
+{
+    _hits = 0;
+    _misses = 0;
+}
+
+u64 ShapeMaskCache::hash_key(u32 kind, std::span<const float> key)
+{
+    // FNV-1a over the bits of every value
+    constexpr u64 offset_basis = 14695981039346656037ull;
+    constexpr u64 prime = 1099511628211ull;
+
+    auto hash = offset_basis;
+
+    auto combine = [&](u32 value) {
+        hash ^= value;
+        hash *= prime;
+    };
+
+    combine(kind);
+
+    for (auto value : key)
+        combine(std::bit_cast<u32>(value));
+
+    return hash;
+}
+
+void ShapeMaskCache::evict(usize memory_budget)
+{
+    while (_memory_usage > memory_budget && !_entries.empty())
+    {
+        auto entry = std::prev(_entries.end());
+        auto [first, last] = _lookup.equal_range(entry->hash);
+
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second == entry)
+            {
+                _lookup.erase(it);
+                break;
+            }
+        }
+
+        _memory_usage -= entry->memory_usage;
+        _entries.erase(entry);
+    }
+}
+
+} // namespace zth
@@ -52,6 +52,11 @@ void Sprite::draw(Renderer& renderer) const
     renderer.draw_sprite(*this);
 }
 
+void Sprite::submit(RenderQueue& render_queue) const
+{
+    render_queue.submit(*this, { .layer = layer, .shader = nullptr, .texture = _sprite.getTexture(), .depth = depth });
+}
+
 void Sprite::set_texture_rect(const IntRect& texture_rect)
 {
     _sprite.setTextureRect(static_cast<sf::IntRect>(texture_rect));
@@ -59,14 +64,22 @@ void Sprite::set_texture_rect(const IntRect& texture_rect)
 
 AnimatedSprite::AnimatedSprite(const Texture& texture, const SpriteSize& sprite_size, u32 frames,
                                float frame_length_seconds)
-    : Sprite(texture), _frames(frames), _sprite_size(sprite_size), _frame_length(sf::seconds(frame_length_seconds))
+    : AnimatedSprite(texture,
+                     { .position = { 0, 0 },
+                       .size = { static_cast<i32>(texture.width()), static_cast<i32>(texture.height()) } },
+                     sprite_size, frames, frame_length_seconds)
+{}
+
+AnimatedSprite::AnimatedSprite(const Texture& texture, const IntRect& sprite_sheet_rect, const SpriteSize& sprite_size,
+                               u32 frames, float frame_length_seconds)
+    : Sprite(texture), _frames(frames), _sprite_size(sprite_size), _sprite_sheet_position(sprite_sheet_rect.position),
+      _frame_length(sf::seconds(frame_length_seconds))
 {
-    set_texture_rect({ .position = { 0, 0 },
+    set_texture_rect({ .position = _sprite_sheet_position,
                        .size = { static_cast<i32>(sprite_size.width), static_cast<i32>(sprite_size.height) } });
 
-    const auto [tex_width, tex_height] = texture.size();
-    _sprite_sheet_cols = tex_width / _sprite_size.width;
-    _sprite_sheet_rows = tex_height / _sprite_size.height;
+    _sprite_sheet_cols = static_cast<u32>(sprite_sheet_rect.size.x) / _sprite_size.width;
+    _sprite_sheet_rows = static_cast<u32>(sprite_sheet_rect.size.y) / _sprite_size.height;
 }
 
 void AnimatedSprite::animate()
@@ -81,8 +94,12 @@ void AnimatedSprite::animate()
 
 void AnimatedSprite::update_animation_texture_rect()
 {
-    auto x = static_cast<i32>(_current_frame % _sprite_sheet_cols * _sprite_size.width);
-    auto y = static_cast<i32>(_current_frame / _sprite_sheet_cols * _sprite_size.height);
+    // a sprite sheet too small to hold a single frame, e.g. an empty one, has nothing to animate
+    if (_sprite_sheet_cols == 0)
+        return;
+
+    auto x = _sprite_sheet_position.x + static_cast<i32>(_current_frame % _sprite_sheet_cols * _sprite_size.width);
+    auto y = _sprite_sheet_position.y + static_cast<i32>(_current_frame / _sprite_sheet_cols * _sprite_size.height);
 
     set_texture_rect({ .position = { x, y },
                        .size = { static_cast<i32>(_sprite_size.width), static_cast<i32>(_sprite_size.height) } });
@@ -0,0 +1,78 @@
+#include "Zenith/Graphics/SpriteBatch.hpp"
+
+namespace zth {
+
+void SpriteBatch::add(const sf::Sprite& sprite)
+{
+    const auto texture = sprite.getTexture();
+
+    // sfml doesn't draw sprites without a texture either
+    if (!texture)
+        return;
+
+    auto& vertices = get_group(texture).vertices;
+
+    const auto bounds = sprite.getLocalBounds();
+    const auto texture_rect = sprite.getTextureRect();
+    const auto& transform = sprite.getTransform();
+    const auto color = sprite.getColor();
+
+    // the same as in sf::Sprite, a texture rect with a negative size flips the sprite
+    const auto left = static_cast<float>(texture_rect.left);
+    const auto top = static_cast<float>(texture_rect.top);
+    const auto right = left + static_cast<float>(texture_rect.width);
+    const auto bottom = top + static_cast<float>(texture_rect.height);
+
+    const sf::Vertex top_left(transform.transformPoint(0.0f, 0.0f), color, { left, top });
+    const sf::Vertex top_right(transform.transformPoint(bounds.width, 0.0f), color, { right, top });
+    const sf::Vertex bottom_left(transform.transformPoint(0.0f, bounds.height), color, { left, bottom });
+    const sf::Vertex bottom_right(transform.transformPoint(bounds.width, bounds.height), color, { right, bottom });
+
+    vertices.insert(vertices.end(), { top_left, top_right, bottom_left, bottom_left, top_right, bottom_right });
+    _sprite_count++;
+}
+
+void SpriteBatch::draw(sf::RenderTarget& render_target)
+{
+    for (usize i = 0; i < _group_count; i++)
+    {
+        auto& group = _groups[i];
+
+        sf::RenderStates states;
+        states.texture = group.texture;
+
+        render_target.draw(group.vertices.data(), group.vertices.size(), sf::PrimitiveType::Triangles, states);
+        group.vertices.clear();
+    }
+
+    _group_count = 0;
+    _sprite_count = 0;
+}
+
+SpriteBatch::TextureGroup& SpriteBatch::get_group(const sf::Texture* texture)
+{
+    switch (mode)
+    {
+    case SpriteBatchMode::InOrder:
+        if (_group_count > 0 && _groups[_group_count - 1].texture == texture)
+            return _groups[_group_count - 1];
+        break;
+    case SpriteBatchMode::ByTexture:
+        for (usize i = 0; i < _group_count; i++)
+        {
+            if (_groups[i].texture == texture)
+                return _groups[i];
+        }
+        break;
+    }
+
+    if (_group_count == _groups.size())
+        _groups.push_back({ .texture = nullptr, .vertices = {} });
+
+    auto& group = _groups[_group_count++];
+    group.texture = texture;
+
+    return group;
+}
+
+} // namespace zth
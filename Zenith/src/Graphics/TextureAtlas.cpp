@@ -0,0 +1,239 @@
+#include "Zenith/Graphics/TextureAtlas.hpp"
+
+#include <bit>
+
+namespace zth {
+
+// places the rects bottom-left first along the skyline of the rects already placed
+// returns the position of every rect, or nothing if they don't fit within max_height
+static std::optional<std::vector<Vec2u>> pack_skyline(std::span<const Vec2u> sizes, u32 width, u32 max_height,
+                                                      u32& used_height)
+{
+    struct SkylineNode
+    {
+        u32 x;
+        u32 y;
+        u32 width;
+    };
+
+    std::vector<usize> order(sizes.size());
+
+    for (usize i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    // placing the tallest rects first leaves the least space wasted under the skyline
+    std::ranges::stable_sort(order, [&](usize a, usize b) {
+        return sizes[a].y != sizes[b].y ? sizes[a].y > sizes[b].y : sizes[a].x > sizes[b].x;
+    });
+
+    std::vector<SkylineNode> skyline{ { .x = 0, .y = 0, .width = width } };
+    std::vector<Vec2u> positions(sizes.size());
+    used_height = 0;
+
+    for (auto index : order)
+    {
+        const auto size = sizes[index];
+
+        usize best_node = skyline.size();
+        u32 best_y = 0;
+        u32 best_bottom = std::numeric_limits<u32>::max();
+
+        for (usize i = 0; i < skyline.size(); i++)
+        {
+            const auto x = skyline[i].x;
+
+            if (x + size.x > width)
+                break;
+
+            // the rect has to rest on the highest node it spans
+            u32 y = 0;
+
+            for (usize j = i; j < skyline.size() && skyline[j].x < x + size.x; j++)
+                y = std::max(y, skyline[j].y);
+
+            if (y + size.y < best_bottom)
+            {
+                best_node = i;
+                best_y = y;
+                best_bottom = y + size.y;
+            }
+        }
+
+        if (best_node == skyline.size() || best_bottom > max_height)
+            return {};
+
+        const auto x = skyline[best_node].x;
+        positions[index] = { x, best_y };
+        used_height = std::max(used_height, best_bottom);
+
+        // the nodes covered by the rect get cut or removed
+        const auto right = x + size.x;
+        auto it = skyline.begin() + static_cast<std::ptrdiff_t>(best_node);
+        it = skyline.insert(it, { .x = x, .y = best_bottom, .width = size.x });
+        ++it;
+
+        while (it != skyline.end() && it->x < right)
+        {
+            const auto node_right = it->x + it->width;
+
+            if (node_right <= right)
+            {
+                it = skyline.erase(it);
+                continue;
+            }
+
+            it->width = node_right - right;
+            it->x = right;
+            break;
+        }
+
+        // neighbours at the same height become one node
+        for (usize i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].y == skyline[i + 1].y)
+            {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    return positions;
+}
+
+usize TextureAtlas::add_image(const sf::Image& image)
+{
+    _images.push_back(image);
+    return _images.size() - 1;
+}
+
+std::optional<usize> TextureAtlas::add_image_from_file(std::string_view path)
+{
+    if (sf::Image image; image.loadFromFile(path.data()))
+        return add_image(image);
+
+    return {};
+}
+
+std::optional<usize> TextureAtlas::add_image_from_memory(const u8* data, usize data_size)
+{
+    if (sf::Image image; image.loadFromMemory(data, data_size))
+        return add_image(image);
+
+    return {};
+}
+
+bool TextureAtlas::build()
+{
+    // whatever an earlier build left behind is dropped first, so that no failure path can leave rects which don't
+    // match the texture
+    _rects.clear();
+    _texture._texture = sf::Texture{};
+
+    if (_images.empty())
+        return false;
+
+    std::vector<Vec2u> sizes;
+    sizes.reserve(_images.size());
+
+    u64 total_area = 0;
+    u32 min_width = 0;
+
+    for (const auto& image : _images)
+    {
+        const auto image_size = image.getSize();
+        const Vec2u size = { image_size.x + 2 * padding, image_size.y + 2 * padding };
+
+        sizes.push_back(size);
+        total_area += static_cast<u64>(size.x) * size.y;
+        min_width = std::max(min_width, size.x);
+    }
+
+    // start from a square big enough to hold every image and widen it until everything fits
+    auto width = std::bit_ceil(static_cast<u32>(std::ceil(std::sqrt(static_cast<double>(total_area)))));
+    width = std::max(width, min_width);
+
+    std::optional<std::vector<Vec2u>> positions;
+    u32 height = 0;
+
+    for (; width <= max_size; width *= 2)
+    {
+        positions = pack_skyline(sizes, width, max_size, height);
+
+        if (positions)
+            break;
+    }
+
+    if (!positions)
+        return false;
+
+    sf::Image atlas;
+    atlas.create(width, height, sf::Color::Transparent);
+
+    _rects.reserve(_images.size());
+
+    for (usize i = 0; i < _images.size(); i++)
+    {
+        const Vec2u position = { (*positions)[i].x + padding, (*positions)[i].y + padding };
+        copy_image(atlas, _images[i], position);
+
+        _rects.push_back({
+            .position = static_cast<Vec2i>(position),
+            .size = static_cast<Vec2i>(Vec2u{ _images[i].getSize() }),
+        });
+    }
+
+    if (!_texture._texture.loadFromImage(atlas))
+    {
+        _rects.clear();
+        _texture._texture = sf::Texture{};
+        return false;
+    }
+
+    return true;
+}
+
+IntRect TextureAtlas::get_rect(usize image_index) const
+{
+    if (image_index >= _rects.size())
+        return {};
+
+    return _rects[image_index];
+}
+
+void TextureAtlas::copy_image(sf::Image& atlas, const sf::Image& image, const Vec2u& position) const
+{
+    atlas.copy(image, position.x, position.y);
+
+    const auto image_size = image.getSize();
+
+    if (!extrude_edges || padding == 0 || image_size.x == 0 || image_size.y == 0)
+        return;
+
+    const auto left = static_cast<i64>(position.x);
+    const auto top = static_cast<i64>(position.y);
+    const auto pad = static_cast<i64>(padding);
+    const auto width = static_cast<i64>(image_size.x);
+    const auto height = static_cast<i64>(image_size.y);
+
+    for (i64 y = -pad; y < height + pad; y++)
+    {
+        for (i64 x = -pad; x < width + pad; x++)
+        {
+            // the inside has already been copied
+            if (y >= 0 && y < height && x == 0)
+                x = width;
+
+            const auto source_x = static_cast<u32>(std::clamp(x, i64{ 0 }, width - 1));
+            const auto source_y = static_cast<u32>(std::clamp(y, i64{ 0 }, height - 1));
+
+            atlas.setPixel(static_cast<u32>(left + x), static_cast<u32>(top + y), image.getPixel(source_x, source_y));
+        }
+    }
+}
+
+} // namespace zth
@@ -0,0 +1,338 @@
+#include "Zenith/Graphics/TiledPrimitiveRenderer.hpp"
+
+#include "Zenith/Core/Engine.hpp"
+#include "Zenith/Core/Typedefs.hpp"
+#include "Zenith/Graphics/Rasterizer.hpp"
+
+namespace zth {
+
+usize TiledPrimitiveRenderer::thread_count() const
+{
+    if (!engine)
+        return 1;
+
+    return engine->job_system.thread_count();
+}
+
+void TiledPrimitiveRenderer::draw_point_impl(const Vec2f& point, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::Point, color, point);
+}
+
+void TiledPrimitiveRenderer::draw_points_impl(std::span<const Vec2f> points, const Color& color)
+{
+    for (const auto& point : points)
+        _commands.emplace_back(DrawCommandType::Point, color, point);
+}
+
+void TiledPrimitiveRenderer::draw_line_impl(const Vec2f& from, const Vec2f& to, const Color& color)
+{
+    record_line(from, to, color);
+}
+
+void TiledPrimitiveRenderer::draw_line_impl(const Line& line, const Color& color)
+{
+    record_line(line.from, line.to, color);
+}
+
+void TiledPrimitiveRenderer::draw_line_strip_impl(std::span<const Vec2f> points, const Color& color)
+{
+    for (const auto line : points | std::views::adjacent<2>)
+    {
+        const auto& [from, to] = line;
+        record_line(from, to, color);
+    }
+}
+
+void TiledPrimitiveRenderer::draw_lines_impl(std::span<const Line> lines, const Color& color)
+{
+    for (const auto& line : lines)
+        record_line(line.from, line.to, color);
+}
+
+void TiledPrimitiveRenderer::draw_closed_lines_impl(std::span<const Vec2f> points, const Color& color)
+{
+    draw_line_strip_impl(points, color);
+    record_line(points.back(), points.front(), color);
+}
+
+void TiledPrimitiveRenderer::draw_closed_lines_impl(std::span<const Line> lines, const Color& color)
+{
+    draw_lines_impl(lines, color);
+
+    if (lines.size() < 2)
+        return;
+
+    record_line(lines.back().to, lines.front().from, color);
+}
+
+void TiledPrimitiveRenderer::draw_triangle_impl(const Triangle& triangle, const Color& color)
+{
+    draw_line_strip_impl(triangle.points, color);
+    record_line(triangle.points.back(), triangle.points.front(), color);
+}
+
+void TiledPrimitiveRenderer::draw_filled_triangle_impl(const Triangle& triangle, const Color& color)
+{
+    draw_filled_convex_polygon_impl(triangle.points, color);
+}
+
+void TiledPrimitiveRenderer::draw_rect_impl(const Rect& rect, const Color& color)
+{
+    auto points = rect.points();
+    draw_line_strip_impl(points, color);
+    record_line(points.back(), points.front(), color);
+}
+
+void TiledPrimitiveRenderer::draw_filled_rect_impl(const Rect& rect, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::FilledRect, color, rect);
+}
+
+void TiledPrimitiveRenderer::draw_convex_polygon_impl(std::span<const Vec2f> points, const Color& color)
+{
+    draw_line_strip_impl(points, color);
+
+    if (points.size() < 3)
+        return;
+
+    record_line(points.back(), points.front(), color);
+}
+
+void TiledPrimitiveRenderer::draw_convex_polygon_impl(std::span<const Line> lines, const Color& color)
+{
+    draw_lines_impl(lines, color);
+}
+
+void TiledPrimitiveRenderer::draw_filled_convex_polygon_impl(std::span<const Vec2f> points, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::FilledConvexPolygon, color,
+                           PointRange{ .first = _polygon_points.size(), .count = points.size() });
+    _polygon_points.insert(_polygon_points.end(), points.begin(), points.end());
+}
+
+void TiledPrimitiveRenderer::draw_filled_convex_polygon_impl(std::span<const Line> lines, const Color& color)
+{
+    // the lines are connected, so the polygon is made up of their starting points
+    _commands.emplace_back(DrawCommandType::FilledConvexPolygon, color,
+                           PointRange{ .first = _polygon_points.size(), .count = lines.size() });
+    std::ranges::transform(lines, std::back_inserter(_polygon_points), &Line::from);
+}
+
+void TiledPrimitiveRenderer::draw_circle_impl(const Circle& circle, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::Ellipse, color, Ellipse{ circle.center, { circle.radius, circle.radius } });
+}
+
+void TiledPrimitiveRenderer::draw_ellipse_impl(const Ellipse& ellipse, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::Ellipse, color, ellipse);
+}
+
+void TiledPrimitiveRenderer::draw_filled_circle_impl(const Circle& circle, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::FilledEllipse, color,
+                           Ellipse{ circle.center, { circle.radius, circle.radius } });
+}
+
+void TiledPrimitiveRenderer::draw_filled_ellipse_impl(const Ellipse& ellipse, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::FilledEllipse, color, ellipse);
+}
+
+void TiledPrimitiveRenderer::flush_impl()
+{
+    if (_commands.empty())
+        return;
+
+    const auto render_target_size = _render_target->getSize();
+
+    if (_framebuffer.getSize() != render_target_size)
+        _framebuffer.create(render_target_size.x, render_target_size.y);
+
+    bin_commands();
+
+    if (engine)
+    {
+        engine->job_system.parallel_for(_tiles.size(), [&](usize tile_index) { rasterize_tile(tile_index); });
+    }
+    else
+    {
+        for (usize tile_index = 0; tile_index < _tiles.size(); tile_index++)
+            rasterize_tile(tile_index);
+    }
+
+    _commands.clear();
+    _polygon_points.clear();
+
+    if (_framebuffer_texture.getSize() != render_target_size)
+    {
+        if (!_framebuffer_texture.create(render_target_size.x, render_target_size.y))
+            return;
+    }
+
+    _framebuffer_texture.update(_framebuffer);
+
+    sf::Sprite sprite(_framebuffer_texture);
+    _render_target->draw(sprite);
+}
+
+void TiledPrimitiveRenderer::record_line(const Vec2f& from, const Vec2f& to, const Color& color)
+{
+    _commands.emplace_back(DrawCommandType::Line, color, Line{ from, to });
+}
+
+void TiledPrimitiveRenderer::bin_commands()
+{
+    const auto framebuffer_size = static_cast<Vec2i>(Vec2u{ _framebuffer.getSize() });
+
+    _tile_count = { (framebuffer_size.x + tile_size - 1) / tile_size,
+                    (framebuffer_size.y + tile_size - 1) / tile_size };
+    _tiles.resize(static_cast<usize>(_tile_count.x) * static_cast<usize>(_tile_count.y));
+
+    // the tiles keep their capacity between frames
+    for (auto& tile : _tiles)
+        tile.clear();
+
+    for (usize i = 0; i < _commands.size(); i++)
+    {
+        if (auto bounds = get_command_bounds(_commands[i]))
+            bin_command(static_cast<u32>(i), *bounds);
+    }
+}
+
+void TiledPrimitiveRenderer::bin_command(u32 command_index, const IntRect& bounds)
+{
+    auto first_tile_x = bounds.position.x / tile_size;
+    auto first_tile_y = bounds.position.y / tile_size;
+    auto last_tile_x = (bounds.position.x + bounds.size.x - 1) / tile_size;
+    auto last_tile_y = (bounds.position.y + bounds.size.y - 1) / tile_size;
+
+    for (auto tile_y = first_tile_y; tile_y <= last_tile_y; tile_y++)
+    {
+        for (auto tile_x = first_tile_x; tile_x <= last_tile_x; tile_x++)
+            _tiles[static_cast<usize>(tile_y * _tile_count.x + tile_x)].push_back(command_index);
+    }
+}
+
+// the bounds get padded by a pixel on each side, so that rounding in the rasterizers can't leave a pixel out of the
+// tiles that a command gets binned into
+static std::optional<IntRect> get_padded_bounds(const Vec2i& min, const Vec2i& max, const Vec2u& size)
+{
+    auto left = std::max(min.x - 1, 0);
+    auto top = std::max(min.y - 1, 0);
+    auto right = std::min(max.x + 2, static_cast<i32>(size.x));
+    auto bottom = std::min(max.y + 2, static_cast<i32>(size.y));
+
+    if (left >= right || top >= bottom)
+        return {};
+
+    return IntRect{ .position = { left, top }, .size = { right - left, bottom - top } };
+}
+
+std::optional<IntRect> TiledPrimitiveRenderer::get_command_bounds(const DrawCommand& command) const
+{
+    const auto framebuffer_size = Vec2u{ _framebuffer.getSize() };
+
+    switch (command.type)
+    {
+    case DrawCommandType::Point:
+    {
+        auto pixel = to_pixel(command.point);
+        return get_padded_bounds(pixel, pixel, framebuffer_size);
+    }
+    case DrawCommandType::Line:
+    {
+        auto [from, to] = command.line;
+        return get_padded_bounds(to_pixel({ std::min(from.x, to.x), std::min(from.y, to.y) }),
+                                 to_pixel({ std::max(from.x, to.x), std::max(from.y, to.y) }), framebuffer_size);
+    }
+    case DrawCommandType::Ellipse:
+    {
+        // the custom renderer skips outlines whose bounds lie off screen, even though the rounded radius could still
+        // make them reach it
+        if (!get_raster_bounds(command.ellipse.bounds(), framebuffer_size))
+            return {};
+
+        auto center = to_pixel(command.ellipse.center);
+        Vec2i radius = { std::abs(to_pixel_radius(command.ellipse.radius.x)),
+                         std::abs(to_pixel_radius(command.ellipse.radius.y)) };
+
+        return get_padded_bounds(center - radius, center + radius, framebuffer_size);
+    }
+    case DrawCommandType::FilledRect:
+    {
+        auto [x1, y1] = command.rect.position;
+        auto [x2, y2] = command.rect.position + command.rect.size;
+
+        return get_padded_bounds(to_pixel({ std::min(x1, x2), std::min(y1, y2) }),
+                                 to_pixel({ std::max(x1, x2), std::max(y1, y2) }), framebuffer_size);
+    }
+    case DrawCommandType::FilledConvexPolygon:
+    {
+        if (command.polygon.count == 0)
+            return {};
+
+        std::span points{ _polygon_points.data() + command.polygon.first, command.polygon.count };
+
+        auto [min_x, max_x] = std::ranges::minmax(points | std::views::transform(&Vec2f::x));
+        auto [min_y, max_y] = std::ranges::minmax(points | std::views::transform(&Vec2f::y));
+
+        return get_padded_bounds(to_pixel({ min_x, min_y }), to_pixel({ max_x, max_y }), framebuffer_size);
+    }
+    case DrawCommandType::FilledEllipse:
+    {
+        auto bounds = command.ellipse.bounds();
+        return get_padded_bounds(to_pixel(bounds.position), to_pixel(bounds.position + bounds.size),
+                                 framebuffer_size);
+    }
+    }
+
+    assert(false);
+    std::unreachable();
+}
+
+void TiledPrimitiveRenderer::rasterize_tile(usize tile_index)
+{
+    const auto tile_count_x = static_cast<usize>(_tile_count.x);
+    const auto tile_x = static_cast<i32>(tile_index % tile_count_x);
+    const auto tile_y = static_cast<i32>(tile_index / tile_count_x);
+
+    // every thread writes only to the pixels of its own tiles, so no synchronization is needed
+    ImageRasterizer rasterizer{ _framebuffer, IntRect{ .position = { tile_x * tile_size, tile_y * tile_size },
+                                                       .size = { tile_size, tile_size } } };
+
+    rasterizer.clear(Color::transparent);
+    // translucent primitives compose over the ones drawn before them, the same as in the other renderers
+    rasterizer.blend = true;
+
+    for (auto command_index : _tiles[tile_index])
+    {
+        const auto& command = _commands[command_index];
+
+        switch (command.type)
+        {
+        case DrawCommandType::Point:
+            rasterizer.draw_point(command.point, command.color);
+            break;
+        case DrawCommandType::Line:
+            rasterizer.draw_line(command.line, command.color);
+            break;
+        case DrawCommandType::Ellipse:
+            rasterizer.draw_ellipse(command.ellipse, command.color);
+            break;
+        case DrawCommandType::FilledRect:
+            rasterizer.fill_rect(command.rect, command.color);
+            break;
+        case DrawCommandType::FilledConvexPolygon:
+            rasterizer.fill_convex_polygon(
+                std::span{ _polygon_points.data() + command.polygon.first, command.polygon.count }, command.color);
+            break;
+        case DrawCommandType::FilledEllipse:
+            rasterizer.fill_ellipse(command.ellipse, command.color);
+            break;
+        }
+    }
+}
+
+} // namespace zth
@@ -0,0 +1,49 @@
+#include "Zenith/Graphics/UnitCircleCache.hpp"
+
+namespace zth {
+
+usize UnitCircleCache::get_level(float radius, float tolerance)
+{
+    constexpr auto pi = std::numbers::pi_v<float>;
+
+    for (usize level = 0; level < level_count; level++)
+    {
+        // the furthest a chord between two neighbouring points gets from the circle
+        float error = radius * (1.0f - std::cos(pi / static_cast<float>(get_point_count(level))));
+
+        if (error <= tolerance)
+            return level;
+    }
+
+    return level_count - 1;
+}
+
+std::span<const Vec2f> UnitCircleCache::get_ring(usize level)
+{
+    assert(level < level_count);
+
+    auto& ring = _rings[level];
+
+    if (!ring.empty())
+        return ring;
+
+    constexpr auto pi = std::numbers::pi_v<float>;
+    const auto point_count = get_point_count(level);
+
+    ring.reserve(point_count);
+
+    for (usize i = 0; i < point_count; i++)
+    {
+        float angle = static_cast<float>(i) * 2.0f * pi / static_cast<float>(point_count) - pi / 2.0f;
+        ring.emplace_back(std::cos(angle), std::sin(angle));
+    }
+
+    return ring;
+}
+
+std::span<const Vec2f> UnitCircleCache::get_ring(float radius, float tolerance)
+{
+    return get_ring(get_level(radius, tolerance));
+}
+
+} // namespace zth
@@ -1,5 +1,7 @@
 #include "Zenith/Graphics/VertexArray.hpp"
 
+#include <cstring>
+
 #include "Zenith/Graphics/Renderer.hpp"
 
 namespace zth {
@@ -73,9 +75,50 @@ const char* to_string(PrimitiveType primitive_type)
     return "Unknown";
 }
 
+Rect get_bounds(std::span<const Vertex> vertices)
+{
+    if (vertices.empty())
+        return {};
+
+    auto min = vertices.front().position;
+    auto max = vertices.front().position;
+
+    for (const auto& vertex : vertices)
+    {
+        min = { std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y) };
+        max = { std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y) };
+    }
+
+    return { .position = min, .size = max - min };
+}
+
 void VertexArray::draw(Renderer& renderer) const
 {
     renderer.draw_vertex_array(*this);
 }
 
+void VertexArray::append(std::span<const Vertex> vertices)
+{
+    if (vertices.empty())
+        return;
+
+    auto destination = append(vertices.size());
+    std::memcpy(destination.data(), vertices.data(), vertices.size_bytes());
+}
+
+std::span<Vertex> VertexArray::append(usize count)
+{
+    const auto old_size = _vertices.size();
+    _vertices.resize(old_size + count);
+    return std::span{ _vertices }.subspan(old_size);
+}
+
+void VertexArray::draw_to(sf::RenderTarget& render_target) const
+{
+    if (_vertices.empty())
+        return;
+
+    render_target.draw(to_sf_vertices(_vertices.data()), _vertices.size(), to_sf_primitive_type(_primitive_type));
+}
+
 } // namespace zth
@@ -0,0 +1,91 @@
+#include "Zenith/Graphics/VertexBuffer.hpp"
+
+#include "Zenith/Graphics/Renderer.hpp"
+
+namespace zth {
+
+static Rect get_union(const Rect& a, const Rect& b)
+{
+    const Vec2f min = { std::min(a.position.x, b.position.x), std::min(a.position.y, b.position.y) };
+    const Vec2f max = { std::max(a.position.x + a.size.x, b.position.x + b.size.x),
+                        std::max(a.position.y + a.size.y, b.position.y + b.size.y) };
+
+    return { .position = min, .size = max - min };
+}
+
+sf::VertexBuffer::Usage to_sf_vertex_buffer_usage(VertexBufferUsage usage)
+{
+    switch (usage)
+    {
+    case VertexBufferUsage::Static:
+        return sf::VertexBuffer::Usage::Static;
+    case VertexBufferUsage::Dynamic:
+        return sf::VertexBuffer::Usage::Dynamic;
+    case VertexBufferUsage::Stream:
+        return sf::VertexBuffer::Usage::Stream;
+    }
+
+    assert(false);
+    std::unreachable();
+}
+
+const char* to_string(VertexBufferUsage usage)
+{
+    switch (usage)
+    {
+        using enum VertexBufferUsage;
+    case Static:
+        return "Static";
+    case Dynamic:
+        return "Dynamic";
+    case Stream:
+        return "Stream";
+    }
+
+    assert(false);
+    return "Unknown";
+}
+
+VertexBuffer::VertexBuffer(PrimitiveType primitive_type, VertexBufferUsage usage)
+    : _vertex_buffer(to_sf_primitive_type(primitive_type), to_sf_vertex_buffer_usage(usage)), _usage(usage)
+{}
+
+VertexBuffer::VertexBuffer(PrimitiveType primitive_type, std::span<const Vertex> vertices, VertexBufferUsage usage)
+    : VertexBuffer(primitive_type, usage)
+{
+    set_vertices(vertices);
+}
+
+void VertexBuffer::draw(Renderer& renderer) const
+{
+    renderer.draw_vertex_buffer(*this);
+}
+
+bool VertexBuffer::set_vertices(std::span<const Vertex> vertices)
+{
+    // the buffer only gets reallocated when its size changes
+    if (vertices.size() != _vertex_buffer.getVertexCount() && !_vertex_buffer.create(vertices.size()))
+        return false;
+
+    _bounds = get_bounds(vertices);
+
+    if (vertices.empty())
+        return true;
+
+    return _vertex_buffer.update(to_sf_vertices(vertices.data()));
+}
+
+bool VertexBuffer::update(std::span<const Vertex> vertices, usize offset)
+{
+    if (vertices.empty())
+        return true;
+
+    if (offset + vertices.size() > _vertex_buffer.getVertexCount())
+        return false;
+
+    _bounds = get_union(_bounds, get_bounds(vertices));
+
+    return _vertex_buffer.update(to_sf_vertices(vertices.data()), vertices.size(), static_cast<unsigned int>(offset));
+}
+
+} // namespace zth
@@ -0,0 +1,32 @@
+#version 120
+
+// the rows of the view transform from world space to normalized device coordinates
+uniform vec3 u_view_x;
+uniform vec3 u_view_y;
+
+// a corner of the unit square, the same for every instance
+attribute vec2 a_corner;
+
+// per instance, the rows of the transform from the unit square to world space
+attribute vec3 a_transform_x;
+attribute vec3 a_transform_y;
+attribute vec4 a_color;
+attribute vec4 a_uv_rect;
+
+varying vec4 v_color;
+varying vec2 v_uv;
+varying vec2 v_corner;
+
+void main()
+{
+	vec3 corner = vec3(a_corner, 1.0);
+	vec3 position = vec3(dot(a_transform_x, corner), dot(a_transform_y, corner), 1.0);
+
+	gl_Position = vec4(dot(u_view_x, position), dot(u_view_y, position), 0.0, 1.0);
+	v_color = a_color;
+	// the texture rect is in pixels, sfml's texture matrix normalizes it and accounts for textures padded to a power of
+	// two or stored upside down (e.g. render textures)
+	vec2 uv = a_uv_rect.xy + a_corner * a_uv_rect.zw;
+	v_uv = (gl_TextureMatrix[0] * vec4(uv, 0.0, 1.0)).xy;
+	v_corner = a_corner;
+}
@@ -0,0 +1,15 @@
+#version 120
+
+varying vec4 v_color;
+varying vec2 v_corner;
+
+void main()
+{
+	// the circle is inscribed in the unit square
+	vec2 offset = v_corner * 2.0 - 1.0;
+
+	if (dot(offset, offset) > 1.0)
+		discard;
+
+	gl_FragColor = v_color;
+}
@@ -0,0 +1,11 @@
+#version 120
+
+uniform sampler2D u_texture;
+
+varying vec4 v_color;
+varying vec2 v_uv;
+
+void main()
+{
+	gl_FragColor = texture2D(u_texture, v_uv) * v_color;
+}